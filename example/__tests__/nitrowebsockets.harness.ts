@@ -1,6 +1,9 @@
+import { Platform } from 'react-native';
 import { describe, it, expect } from 'react-native-harness';
-import { NitroWebSocket } from 'react-native-nitro-websockets';
+import { NitroWebSocket, createWebSocket } from 'react-native-nitro-websockets';
+import { TextDecoder } from 'react-native-nitro-text-decoder';
 import type {
+  NitroWebSocketOptions,
   WebSocketMessageEvent,
   WebSocketCloseEvent,
 } from 'react-native-nitro-websockets';
@@ -434,6 +437,304 @@ describe('NitroWebSocket - Handshake headers', () => {
   });
 });
 
+// ─── Batched delivery ────────────────────────────────────────────────────────
+// /ws/burst answers "burst <n>" with n numbered messages sent back to back, so
+// most of them arrive within one batching window.
+
+function openLocal(
+  path: string,
+  options?: NitroWebSocketOptions
+): Promise<NitroWebSocket> {
+  return withTimeout(
+    new Promise<NitroWebSocket>((resolve, reject) => {
+      const ws = new NitroWebSocket(`${WS_BASE}${path}`, [], {}, options);
+      ws.onopen = () => resolve(ws);
+      ws.onerror = (err) => reject(new Error(`Connection error: ${err}`));
+    })
+  );
+}
+
+function waitFor(
+  condition: () => boolean,
+  ms = TIMEOUT_MS,
+  label = 'condition'
+): Promise<void> {
+  return withTimeout(
+    new Promise<void>((resolve) => {
+      const poll = () => (condition() ? resolve() : setTimeout(poll, 10));
+      poll();
+    }),
+    ms,
+    label
+  );
+}
+
+const numbered = (n: number) => Array.from({ length: n }, (_, i) => String(i));
+
+describe('NitroWebSocket - Batched delivery', () => {
+  it('delivers a burst in order, in batches no larger than maxMessages', async () => {
+    const ws = await openLocal('/ws/burst', {
+      batch: { windowMs: 50, maxMessages: 16 },
+    });
+    const batches: string[][] = [];
+    ws.onmessages = (events) => batches.push(events.map((e) => e.data));
+    ws.send('burst 200');
+
+    await waitFor(() => batches.flat().length >= 200, TIMEOUT_MS, 'burst');
+    expect(batches.flat()).toEqual(numbered(200));
+    expect(batches.every((b) => b.length >= 1 && b.length <= 16)).toBe(true);
+    expect(batches.some((b) => b.length > 1)).toBe(true);
+    await closeAndWait(ws);
+  });
+
+  it('hands a lone message after a quiet window to onmessage', async () => {
+    const ws = await openLocal('/ws/burst', { batch: { windowMs: 20 } });
+    const singles: string[] = [];
+    const batches: string[][] = [];
+    ws.onmessage = (e) => singles.push(e.data);
+    ws.onmessages = (events) => batches.push(events.map((e) => e.data));
+    ws.send('burst 1');
+
+    await waitFor(() => singles.length === 1, TIMEOUT_MS, 'single');
+    expect(singles).toEqual(['0']);
+    expect(batches).toEqual([]);
+    await closeAndWait(ws);
+  });
+
+  it('loses and reorders nothing when the handlers are swapped mid-burst', async () => {
+    // A long window keeps messages pending in the batcher at each swap.
+    const ws = await openLocal('/ws/burst', {
+      batch: { windowMs: 200, maxMessages: 64 },
+    });
+    const received: string[] = [];
+    let stage = 0;
+    const collect = (events: { data: string }[]) => {
+      for (const e of events) received.push(e.data);
+    };
+    ws.onmessages = (events) => {
+      collect(events);
+      if (stage === 0) {
+        stage = 1;
+        // Reassigning onmessages replaces the batcher.
+        ws.onmessages = (more) => {
+          collect(more);
+          if (stage === 1 && received.length >= 500) {
+            stage = 2;
+            // Adding onmessage rebinds it, then dropping onmessages
+            // switches to unbatched delivery.
+            ws.onmessage = (e) => received.push(e.data);
+            ws.onmessages = null;
+          }
+        };
+      }
+    };
+    ws.send('burst 2000');
+
+    await waitFor(() => received.length >= 2000, TIMEOUT_MS, 'swapped burst');
+    await new Promise<void>((resolve) => setTimeout(resolve, 300));
+    expect(stage).toBe(2);
+    expect(received).toEqual(numbered(2000));
+    await closeAndWait(ws);
+  });
+});
+
+// ─── Message payloads ────────────────────────────────────────────────────────
+// Native validates text on the receive thread and hands it to JS as a string;
+// a text frame that is not UTF-8 fails the connection with 1007 (RFC 6455
+// §8.1) before any JS runs for it. /ws/invalid-utf8 follows the bad frame
+// with a valid "after" message, which must never be delivered: nothing is
+// processed once the connection is failed (§7.1.7).
+
+describe('NitroWebSocket - Message payloads', () => {
+  // Gives anything still queued for the JS thread time to arrive.
+  const settle = () => new Promise<void>((resolve) => setTimeout(resolve, 300));
+
+  function echo(ws: NitroWebSocket, data: string | ArrayBuffer) {
+    const reply = nextMessage(ws);
+    ws.send(data);
+    return reply;
+  }
+
+  it('delivers text as a string, ASCII and non-ASCII alike', async () => {
+    const ws = await openLocal('/ws/echo');
+    for (const text of ['plain ascii', 'héllo wörld', '日本語 😀', '']) {
+      const e = await echo(ws, text);
+      expect(typeof e.data).toBe('string');
+      expect(e.data).toBe(text);
+      expect(e.isBinary).toBe(false);
+      expect(e.binaryData).toBe(undefined);
+    }
+    await closeAndWait(ws);
+  });
+
+  it('delivers a large multi-byte text message intact', async () => {
+    const ws = await openLocal('/ws/echo');
+    const text = 'ünïcødé 😀 '.repeat(8_000);
+    const e = await echo(ws, text);
+    expect(e.data.length).toBe(text.length);
+    expect(e.data === text).toBe(true);
+    await closeAndWait(ws);
+  });
+
+  it('delivers binary as an ArrayBuffer with empty data', async () => {
+    const ws = await openLocal('/ws/echo');
+    const bytes = [0, 0xff, 0x80, 0x7f];
+    const e = await echo(ws, new Uint8Array(bytes).buffer);
+    expect(e.isBinary).toBe(true);
+    expect(e.data).toBe('');
+    expect(Array.from(new Uint8Array(e.binaryData!))).toEqual(bytes);
+    await closeAndWait(ws);
+  });
+
+  it('closes with 1007 on a text frame that is not UTF-8', async () => {
+    const messages: string[] = [];
+    const closeEvent = await withTimeout(
+      new Promise<WebSocketCloseEvent>((resolve) => {
+        const ws = new NitroWebSocket(`${WS_BASE}/ws/invalid-utf8`);
+        ws.onmessage = (e) => messages.push(e.data);
+        ws.onclose = resolve;
+      }),
+      TIMEOUT_MS,
+      '1007 close'
+    );
+    await settle();
+    expect(messages).toEqual(['valid']);
+    expect(closeEvent.code).toBe(1007);
+  });
+
+  it('closes with 1007 on batched delivery too', async () => {
+    const messages: string[] = [];
+    const closeEvent = await withTimeout(
+      new Promise<WebSocketCloseEvent>((resolve) => {
+        const ws = new NitroWebSocket(
+          `${WS_BASE}/ws/invalid-utf8`,
+          [],
+          {},
+          { batch: { windowMs: 50 } }
+        );
+        ws.onmessages = (events) => {
+          for (const e of events) messages.push(e.data);
+        };
+        ws.onclose = resolve;
+      }),
+      TIMEOUT_MS,
+      '1007 close (batched)'
+    );
+    await settle();
+    expect(messages).toEqual(['valid']);
+    expect(closeEvent.code).toBe(1007);
+  });
+
+  it('drops a message that follows the invalid frame on the onMessage path', async () => {
+    const ws = createWebSocket();
+    const messages: string[] = [];
+    const decoder = new TextDecoder();
+    const closeEvent = await withTimeout(
+      new Promise<WebSocketCloseEvent>((resolve) => {
+        ws.onMessage = (e) => messages.push(decoder.decode(e.data));
+        ws.onClose = resolve;
+        ws.connect(`${WS_BASE}/ws/invalid-utf8`, [], {});
+      }),
+      TIMEOUT_MS,
+      '1007 close (onMessage)'
+    );
+    await settle();
+    expect(messages).toEqual(['valid']);
+    expect(closeEvent.code).toBe(1007);
+  });
+});
+
+// ─── permessage-deflate ──────────────────────────────────────────────────────
+// /ws/frames answers each message with the header of the frame it arrived in,
+// so these check the RSV1 bit libwebsockets actually put on the wire: clear
+// for messages under minCompressSize, which bypass the deflate stream, and
+// set for the rest. Deflate is offered on Android only; iOS sends plain
+// frames.
+
+type FrameReport = {
+  rsv1: boolean;
+  opcode: number;
+  frames: number;
+  wireBytes: number;
+};
+
+describe('NitroWebSocket - permessage-deflate', () => {
+  const deflating = Platform.OS === 'android';
+
+  async function report(
+    ws: NitroWebSocket,
+    data: string | ArrayBuffer
+  ): Promise<FrameReport> {
+    const reply = nextMessage(ws);
+    ws.send(data);
+    return JSON.parse((await reply).data) as FrameReport;
+  }
+
+  it('negotiates the extension', async () => {
+    const ws = await openLocal('/ws/frames', { perMessageDeflate: true });
+    expect(ws.extensions.includes('permessage-deflate')).toBe(deflating);
+    await closeAndWait(ws);
+  });
+
+  it('leaves RSV1 clear below minCompressSize and sets it above', async () => {
+    const ws = await openLocal('/ws/frames', {
+      perMessageDeflate: { minCompressSize: 100 },
+    });
+    const small = 'x'.repeat(99);
+    const large = 'x'.repeat(4000);
+
+    // Small after large too: the bypass must not reuse the last header.
+    for (const [text, compressed] of [
+      [small, false],
+      [large, deflating],
+      [small, false],
+      [large, deflating],
+    ] as const) {
+      const r = await report(ws, text);
+      expect(r.rsv1).toBe(compressed);
+      expect(r.opcode).toBe(1);
+      if (compressed) expect(r.wireBytes).toBeLessThan(text.length);
+      else expect(r.wireBytes).toBe(text.length);
+    }
+
+    const stats = ws.getCompressionStats();
+    expect(stats.messagesSent).toBe(deflating ? 4 : 0);
+    expect(stats.messagesSentCompressed).toBe(deflating ? 2 : 0);
+    await closeAndWait(ws);
+  });
+
+  it('compresses a message of exactly minCompressSize bytes', async () => {
+    const ws = await openLocal('/ws/frames', {
+      perMessageDeflate: { minCompressSize: 100 },
+    });
+    expect((await report(ws, 'x'.repeat(100))).rsv1).toBe(deflating);
+    await closeAndWait(ws);
+  });
+
+  it('applies the threshold to binary messages', async () => {
+    const ws = await openLocal('/ws/frames', {
+      perMessageDeflate: { minCompressSize: 100 },
+    });
+    const small = await report(ws, new Uint8Array(10).buffer);
+    expect(small.rsv1).toBe(false);
+    expect(small.opcode).toBe(2);
+    expect(small.wireBytes).toBe(10);
+
+    const large = await report(ws, new Uint8Array(4000).buffer);
+    expect(large.rsv1).toBe(deflating);
+    expect(large.opcode).toBe(2);
+    await closeAndWait(ws);
+  });
+
+  it('compresses everything with minCompressSize 0', async () => {
+    const ws = await openLocal('/ws/frames', {
+      perMessageDeflate: { minCompressSize: 0 },
+    });
+    expect((await report(ws, 'x')).rsv1).toBe(deflating);
+    await closeAndWait(ws);
+  });
+});
+
 // ─── Error Handling ───────────────────────────────────────────────────────────
 
 describe('NitroWebSocket - Error Handling', () => {
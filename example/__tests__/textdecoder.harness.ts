@@ -1,5 +1,13 @@
 import { describe, it, expect } from 'react-native-harness';
-import { TextDecoder } from 'react-native-nitro-text-decoder';
+import {
+  TextDecoder,
+  TextEncoder as NitroTextEncoder,
+  base64Decode,
+  base64Encode,
+  parseJSON,
+  parseJSONLazy,
+  utf8Length,
+} from 'react-native-nitro-text-decoder';
 
 describe('NitroTextDecoder - constructor and metadata', () => {
   it('defaults to utf-8 with fatal=false and ignoreBOM=false', () => {
@@ -15,8 +23,12 @@ describe('NitroTextDecoder - constructor and metadata', () => {
   });
 
   it('throws RangeError for unsupported encoding labels', () => {
-    expect(() => new TextDecoder('utf-16le')).toThrow(RangeError);
-    expect(() => new TextDecoder('iso-8859-1')).toThrow(RangeError);
+    expect(() => new TextDecoder('utf-7')).toThrow(RangeError);
+    expect(() => new TextDecoder('x-unknown')).toThrow(RangeError);
+  });
+
+  it('resolves iso-8859-1 to windows-1252 as the WHATWG spec does', () => {
+    expect(new TextDecoder('iso-8859-1').encoding).toBe('windows-1252');
   });
 
   it('throws RangeError when label is null', () => {
@@ -87,6 +99,147 @@ describe('NitroTextDecoder - decode', () => {
   });
 });
 
+describe('NitroTextDecoder - UTF-16', () => {
+  const u8 = (...b: number[]) => new Uint8Array(b);
+
+  it('resolves the UTF-16 labels', () => {
+    expect(new TextDecoder('utf-16le').encoding).toBe('utf-16le');
+    expect(new TextDecoder('utf-16').encoding).toBe('utf-16le');
+    expect(new TextDecoder('UTF-16BE').encoding).toBe('utf-16be');
+  });
+
+  it('decodes little- and big-endian code units', () => {
+    expect(new TextDecoder('utf-16le').decode(u8(0x68, 0, 0x69, 0))).toBe('hi');
+    expect(new TextDecoder('utf-16be').decode(u8(0, 0x68, 0, 0x69))).toBe('hi');
+    // U+1F600 as a surrogate pair.
+    expect(
+      new TextDecoder('utf-16le').decode(u8(0x3d, 0xd8, 0x00, 0xde))
+    ).toBe('😀');
+    expect(
+      new TextDecoder('utf-16be').decode(u8(0xd8, 0x3d, 0xde, 0x00))
+    ).toBe('😀');
+  });
+
+  it('strips a matching BOM unless ignoreBOM is set', () => {
+    expect(new TextDecoder('utf-16le').decode(u8(0xff, 0xfe, 0x61, 0))).toBe(
+      'a'
+    );
+    expect(new TextDecoder('utf-16be').decode(u8(0xfe, 0xff, 0, 0x61))).toBe(
+      'a'
+    );
+    const kept = new TextDecoder('utf-16le', { ignoreBOM: true }).decode(
+      u8(0xff, 0xfe, 0x61, 0)
+    );
+    expect(kept).toBe('\uFEFFa');
+    // A BOM of the other byte order is an ordinary U+FFFE.
+    expect(new TextDecoder('utf-16le').decode(u8(0xfe, 0xff, 0x61, 0))).toBe(
+      '\uFFFEa'
+    );
+  });
+
+  it('replaces an odd trailing byte with U+FFFD', () => {
+    expect(new TextDecoder('utf-16le').decode(u8(0x61, 0, 0x62))).toBe(
+      'a\uFFFD'
+    );
+    expect(new TextDecoder('utf-16be').decode(u8(0, 0x61, 0))).toBe('a\uFFFD');
+    // A lead surrogate cut off with its odd byte is one error, not two.
+    expect(new TextDecoder('utf-16le').decode(u8(0x3d, 0xd8, 0x00))).toBe(
+      '\uFFFD'
+    );
+    expect(() =>
+      new TextDecoder('utf-16le', { fatal: true }).decode(u8(0x61, 0, 0x62))
+    ).toThrow(TypeError);
+  });
+
+  it('replaces lone surrogates with U+FFFD', () => {
+    const d = new TextDecoder('utf-16le');
+    // Lone low, lone high before a non-surrogate, lone high at the end.
+    expect(d.decode(u8(0x00, 0xdc, 0x61, 0))).toBe('\uFFFDa');
+    expect(d.decode(u8(0x3d, 0xd8, 0x61, 0))).toBe('\uFFFDa');
+    expect(d.decode(u8(0x61, 0, 0x3d, 0xd8))).toBe('a\uFFFD');
+    // Two lows in a row after a pair.
+    expect(d.decode(u8(0x3d, 0xd8, 0x00, 0xde, 0x00, 0xde))).toBe(
+      '😀\uFFFD'
+    );
+    expect(() =>
+      new TextDecoder('utf-16be', { fatal: true }).decode(u8(0xdc, 0x00))
+    ).toThrow(TypeError);
+  });
+
+  it('carries a code unit split across stream calls', () => {
+    const d = new TextDecoder('utf-16le');
+    expect(d.decode(u8(0x61), { stream: true })).toBe('');
+    expect(d.decode(u8(0x00, 0x62), { stream: true })).toBe('a');
+    expect(d.decode(u8(0x00))).toBe('b');
+  });
+
+  it('carries a surrogate pair split across stream calls', () => {
+    const d = new TextDecoder('utf-16be');
+    expect(d.decode(u8(0xd8, 0x3d, 0xde), { stream: true })).toBe('');
+    expect(d.decode(u8(0x00), { stream: true })).toBe('😀');
+    // A lead surrogate still pending at the end of the stream is an error.
+    expect(d.decode(u8(0xd8, 0x3d), { stream: true })).toBe('');
+    expect(d.decode()).toBe('\uFFFD');
+  });
+
+  it('only strips the BOM at the start of a stream', () => {
+    const d = new TextDecoder('utf-16le');
+    expect(d.decode(u8(0xff, 0xfe, 0x61, 0), { stream: true })).toBe('a');
+    expect(d.decode(u8(0xff, 0xfe), { stream: true })).toBe('\uFEFF');
+    expect(d.decode()).toBe('');
+    // The next stream starts fresh.
+    expect(d.decode(u8(0xff, 0xfe, 0x62, 0))).toBe('b');
+  });
+});
+
+describe('NitroTextDecoder - single-byte encodings', () => {
+  it('maps 0x80-0x9F through the windows-1252 table', () => {
+    const d = new TextDecoder('windows-1252');
+    expect(d.decode(new Uint8Array([0x80, 0x85, 0x8a, 0x93, 0x94, 0x9f]))).toBe(
+      '\u20AC\u2026\u0160\u201C\u201D\u0178'
+    );
+    // The five bytes windows-1252 leaves unassigned pass through as C1.
+    expect(d.decode(new Uint8Array([0x81, 0x8d, 0x8f, 0x90, 0x9d]))).toBe(
+      '\u0081\u008D\u008F\u0090\u009D'
+    );
+    // 0xA0-0xFF are Latin-1.
+    expect(d.decode(new Uint8Array([0xa0, 0xe9, 0xff]))).toBe('\u00A0éÿ');
+  });
+
+  it('treats latin1 and ascii as windows-1252 aliases', () => {
+    const bytes = new Uint8Array([0x48, 0x69, 0x80, 0xe9]);
+    for (const label of ['latin1', 'ascii', 'ISO-8859-1', 'us-ascii']) {
+      const d = new TextDecoder(label);
+      expect(d.encoding).toBe('windows-1252');
+      expect(d.decode(bytes)).toBe('Hi\u20ACé');
+    }
+  });
+
+  it('patches high bytes past the 8-byte ASCII fast path', () => {
+    const bytes = new Uint8Array(19).fill(0x61);
+    bytes[8] = 0x80;
+    bytes[18] = 0x99;
+    expect(new TextDecoder('windows-1252').decode(bytes)).toBe(
+      'aaaaaaaa\u20ACaaaaaaaaa\u2122'
+    );
+  });
+
+  it('replaces unmapped bytes in a table with holes', () => {
+    // iso-8859-3 has no character at 0xA5.
+    const bytes = new Uint8Array([0x61, 0xa5, 0xa1]);
+    expect(new TextDecoder('iso-8859-3').decode(bytes)).toBe(
+      'a\uFFFD\u0126'
+    );
+  });
+
+  it('throws TypeError on an unmapped byte when fatal', () => {
+    const d = new TextDecoder('iso-8859-3', { fatal: true });
+    expect(() => d.decode(new Uint8Array([0x61, 0xa5]))).toThrow(TypeError);
+    // Mapped input still decodes afterwards.
+    expect(d.decode(new Uint8Array([0x61, 0xa1]))).toBe('a\u0126');
+  });
+});
+
 describe('NitroTextDecoder - streaming decode', () => {
   it('re-assembles a split multi-byte character across chunks', () => {
     const d = new TextDecoder();
@@ -102,3 +255,412 @@ describe('NitroTextDecoder - streaming decode', () => {
     expect(d.decode(new Uint8Array([0xa0]), { stream: false })).toBe('你');
   });
 });
+
+describe('NitroTextDecoder - decodeMany', () => {
+  const enc = new NitroTextEncoder();
+
+  it('decodes each input and carries state between them', () => {
+    const d = new TextDecoder();
+    // "é" split across two inputs lands in the second string.
+    const parts = d.decodeMany([
+      enc.encode('ab'),
+      new Uint8Array([0x63, 0xc3]),
+      new Uint8Array([0xa9, 0x64]),
+    ]);
+    expect(parts).toEqual(['ab', 'c', 'éd']);
+  });
+
+  it('joins the inputs into one string', () => {
+    const d = new TextDecoder();
+    const joined = d.decodeMany(
+      [
+        enc.encode('hello '),
+        new Uint8Array([0xe2, 0x82]),
+        new Uint8Array([0xac]),
+      ],
+      { join: true }
+    );
+    expect(joined).toBe('hello €');
+    // A single input takes the no-copy path.
+    expect(d.decodeMany([enc.encode('solo')], { join: true })).toBe('solo');
+  });
+
+  it('handles empty batches and empty entries', () => {
+    const d = new TextDecoder();
+    const empty = new Uint8Array(0);
+    expect(d.decodeMany([])).toEqual([]);
+    expect(d.decodeMany([], { join: true })).toBe('');
+    const inputs = [empty, enc.encode('x'), empty];
+    expect(d.decodeMany(inputs)).toEqual(['', 'x', '']);
+    expect(d.decodeMany(inputs, { join: true })).toBe('x');
+  });
+
+  it('reads views at their byteOffset and byteLength', () => {
+    const d = new TextDecoder();
+    const bytes = enc.encode('__abc__def__');
+    const buf = bytes.buffer.slice(
+      bytes.byteOffset,
+      bytes.byteOffset + bytes.byteLength
+    );
+    const inputs = [
+      new Uint8Array(buf, 2, 3),
+      new DataView(buf, 7, 3),
+      buf.slice(0, 2),
+    ];
+    expect(d.decodeMany(inputs)).toEqual(['abc', 'def', '__']);
+    expect(d.decodeMany(inputs, { join: true })).toBe('abcdef__');
+  });
+
+  it('replaces invalid UTF-8 inside a joined batch', () => {
+    const d = new TextDecoder();
+    const joined = d.decodeMany(
+      [enc.encode('ok'), new Uint8Array([0xff]), enc.encode('fine')],
+      { join: true }
+    );
+    expect(joined).toBe('ok\uFFFDfine');
+    // A sequence cut off by the end of the batch is an error too.
+    const cut = [enc.encode('a'), new Uint8Array([0xe2])];
+    expect(d.decodeMany(cut, { join: true })).toBe('a\uFFFD');
+  });
+
+  it('throws TypeError on invalid UTF-8 in a joined batch when fatal', () => {
+    const d = new TextDecoder('utf-8', { fatal: true });
+    expect(() =>
+      d.decodeMany([enc.encode('ok'), new Uint8Array([0xc0, 0x80])], {
+        join: true,
+      })
+    ).toThrow(TypeError);
+    expect(d.decodeMany([enc.encode('ok')], { join: true })).toBe('ok');
+  });
+
+  it('keeps a trailing partial sequence when stream is set', () => {
+    const d = new TextDecoder();
+    expect(
+      d.decodeMany([enc.encode('a'), new Uint8Array([0xf0, 0x9f])], {
+        join: true,
+        stream: true,
+      })
+    ).toBe('a');
+    expect(d.decode(new Uint8Array([0x98, 0x80]))).toBe('😀');
+  });
+
+  it('throws TypeError when inputs is not an array', () => {
+    const d = new TextDecoder();
+    expect(() => d.decodeMany('abc' as any)).toThrow(TypeError);
+    expect(() => d.decodeMany([42 as any])).toThrow(TypeError);
+  });
+});
+
+describe('NitroTextDecoder - string interning', () => {
+  const enc = new NitroTextEncoder();
+  const ping = enc.encode('ping');
+  const pong = enc.encode('pong');
+  const interning = (internMaxBytes: number, internEntries: number) =>
+    new TextDecoder('utf-8', { internMaxBytes, internEntries });
+
+  it('reports all-zero stats when interning is off', () => {
+    const d = new TextDecoder();
+    d.decode(ping);
+    d.decode(ping);
+    expect(d.getInternStats()).toEqual({
+      hits: 0,
+      misses: 0,
+      evictions: 0,
+      entries: 0,
+    });
+  });
+
+  it('returns the cached string on a repeated input', () => {
+    const d = interning(16, 8);
+    expect(d.decode(ping)).toBe('ping');
+    expect(d.decode(ping)).toBe('ping');
+    expect(d.decode(new Uint8Array(ping))).toBe('ping');
+    const stats = d.getInternStats();
+    expect(stats.misses).toBe(1);
+    expect(stats.hits).toBe(2);
+    expect(stats.entries).toBe(1);
+    expect(stats.evictions).toBe(0);
+  });
+
+  it('evicts the previous entry when a slot is reused', () => {
+    // One slot: every new input replaces the last one.
+    const d = interning(16, 1);
+    expect(d.decode(ping)).toBe('ping');
+    expect(d.decode(pong)).toBe('pong');
+    expect(d.decode(ping)).toBe('ping');
+    expect(d.decode(ping)).toBe('ping');
+    expect(d.getInternStats()).toEqual({
+      hits: 1,
+      misses: 3,
+      evictions: 2,
+      entries: 1,
+    });
+  });
+
+  it('skips inputs over internMaxBytes and streamed chunks', () => {
+    const d = interning(4, 8);
+    const long = enc.encode('longer than four');
+    expect(d.decode(long)).toBe('longer than four');
+    expect(d.decode(long)).toBe('longer than four');
+    expect(d.decode(ping, { stream: true })).toBe('ping');
+    expect(d.decode()).toBe('');
+    const stats = d.getInternStats();
+    expect(stats.hits + stats.misses).toBe(0);
+  });
+
+  it('caps internMaxBytes at 256', () => {
+    const d = interning(1 << 20, 1 << 20);
+    const fits = enc.encode('a'.repeat(256));
+    const over = enc.encode('a'.repeat(257));
+    d.decode(fits);
+    d.decode(fits);
+    d.decode(over);
+    d.decode(over);
+    const stats = d.getInternStats();
+    expect(stats.hits).toBe(1);
+    expect(stats.misses).toBe(1);
+  });
+
+  it('resets the counters but keeps the cached strings', () => {
+    const d = interning(16, 8);
+    d.decode(ping);
+    d.resetInternStats();
+    expect(d.decode(ping)).toBe('ping');
+    expect(d.getInternStats()).toEqual({
+      hits: 1,
+      misses: 0,
+      evictions: 0,
+      entries: 1,
+    });
+  });
+});
+
+describe('NitroTextEncoder - encode / encodeInto / utf8Length', () => {
+  it('encodes lone surrogates as U+FFFD (EF BF BD)', () => {
+    const e = new NitroTextEncoder();
+    expect(Array.from(e.encode('\uD800'))).toEqual([0xef, 0xbf, 0xbd]);
+    expect(Array.from(e.encode('a\uDC00b'))).toEqual([
+      0x61, 0xef, 0xbf, 0xbd, 0x62,
+    ]);
+    expect(Array.from(e.encode('\uDE00\uD83D'))).toEqual([
+      0xef, 0xbf, 0xbd, 0xef, 0xbf, 0xbd,
+    ]);
+  });
+
+  it('encodeInto stops at the last code point that fits', () => {
+    const e = new NitroTextEncoder();
+    const dest = new Uint8Array(4);
+    // h (1) + é (2) fit, the next é (2) does not.
+    expect(e.encodeInto('héé', dest)).toEqual({ read: 2, written: 3 });
+    expect(Array.from(dest.subarray(0, 3))).toEqual([0x68, 0xc3, 0xa9]);
+    expect(dest[3]).toBe(0);
+  });
+
+  it('encodeInto never splits a surrogate pair', () => {
+    const e = new NitroTextEncoder();
+    const dest = new Uint8Array(5);
+    // a (1) + 😀 (4 bytes, 2 code units) fit; the second 😀 does not.
+    expect(e.encodeInto('a😀😀', dest)).toEqual({ read: 3, written: 5 });
+    expect(e.encodeInto('😀', new Uint8Array(3))).toEqual({
+      read: 0,
+      written: 0,
+    });
+  });
+
+  it('encodeInto writes at the view offset only', () => {
+    const e = new NitroTextEncoder();
+    const backing = new Uint8Array(6);
+    const view = new Uint8Array(backing.buffer, 2, 3);
+    expect(e.encodeInto('abcd', view)).toEqual({ read: 3, written: 3 });
+    expect(Array.from(backing)).toEqual([0, 0, 0x61, 0x62, 0x63, 0]);
+  });
+
+  it('utf8Length matches the encoded size', () => {
+    expect(utf8Length('')).toBe(0);
+    expect(utf8Length('abc')).toBe(3);
+    expect(utf8Length('é')).toBe(2);
+    expect(utf8Length('你')).toBe(3);
+    expect(utf8Length('😀')).toBe(4);
+    expect(utf8Length('\uD800')).toBe(3);
+    const s = 'mixed ascii, 你好 and 🙂\uDC00';
+    expect(utf8Length(s)).toBe(new NitroTextEncoder().encode(s).length);
+  });
+});
+
+describe('NitroTextEncoder - base64', () => {
+  const bytes = (s: string) => new NitroTextEncoder().encode(s);
+
+  it('pads the standard alphabet', () => {
+    expect(base64Encode(bytes(''))).toBe('');
+    expect(base64Encode(bytes('f'))).toBe('Zg==');
+    expect(base64Encode(bytes('fo'))).toBe('Zm8=');
+    expect(base64Encode(bytes('foo'))).toBe('Zm9v');
+    expect(base64Encode(bytes('foobar'))).toBe('Zm9vYmFy');
+  });
+
+  it('uses - and _ without padding for base64url', () => {
+    const data = new Uint8Array([0xfb, 0xff]);
+    expect(base64Encode(data)).toBe('+/8=');
+    expect(base64Encode(data, { alphabet: 'base64url' })).toBe('-_8');
+    expect(
+      Array.from(base64Decode('-_8', { alphabet: 'base64url' }))
+    ).toEqual([0xfb, 0xff]);
+  });
+
+  it('encodes only the bytes a view covers', () => {
+    const backing = bytes('xfooy');
+    expect(base64Encode(new Uint8Array(backing.buffer, 1, 3))).toBe('Zm9v');
+  });
+
+  it('decodes with and without padding, ignoring ASCII whitespace', () => {
+    expect(Array.from(base64Decode('Zg=='))).toEqual([0x66]);
+    expect(Array.from(base64Decode('Zg'))).toEqual([0x66]);
+    expect(Array.from(base64Decode(' Zm9v\nYmFy\t'))).toEqual(
+      Array.from(bytes('foobar'))
+    );
+    expect(base64Decode('').length).toBe(0);
+  });
+
+  it('round-trips every byte value', () => {
+    const all = new Uint8Array(256);
+    for (let i = 0; i < 256; i++) all[i] = i;
+    expect(Array.from(base64Decode(base64Encode(all)))).toEqual(
+      Array.from(all)
+    );
+  });
+
+  it('throws on characters outside the alphabet', () => {
+    expect(() => base64Decode('Zm9v!')).toThrow();
+    expect(() => base64Decode('Zm9v-_')).toThrow();
+    expect(() => base64Decode('Zm9vé')).toThrow();
+    expect(() => base64Decode('+/8=', { alphabet: 'base64url' })).toThrow();
+  });
+});
+
+describe('parseJSON / parseJSONLazy', () => {
+  const enc = new NitroTextEncoder();
+  const bytes = (text: string) => enc.encode(text);
+
+  async function parseError(text: string): Promise<any> {
+    try {
+      await parseJSON(bytes(text));
+    } catch (e) {
+      return e;
+    }
+    return undefined;
+  }
+
+  it('round-trips a document like JSON.parse', async () => {
+    const text = JSON.stringify({
+      id: 42,
+      name: 'nitro',
+      tags: ['a', 'b', ''],
+      nested: { ok: true, none: null, off: false, list: [1, [2, [3]], {}] },
+      empty: [],
+      dup: 1,
+    }).replace('"dup":1', '"dup":1,"dup":2');
+    expect(await parseJSON(bytes(text))).toEqual(JSON.parse(text));
+    // Top-level scalars.
+    expect(await parseJSON(bytes(' "s" '))).toBe('s');
+    expect(await parseJSON(bytes('null'))).toBe(null);
+    expect(await parseJSONLazy(bytes('12.5'))).toBe(12.5);
+  });
+
+  it('parses a view at its byteOffset', async () => {
+    const buf = bytes('xx[1,2,3]yy');
+    const view = new Uint8Array(buf.buffer, buf.byteOffset + 2, 7);
+    expect(await parseJSON(view)).toEqual([1, 2, 3]);
+  });
+
+  it('rejects malformed input with a SyntaxError and its position', async () => {
+    const cases: Array<[string, string]> = [
+      ['{"a":1,}', 'Expected property name at position 7'],
+      ['[1, 2', "Expected ',' or ']' at position 5"],
+      ['{"a" 1}', "Expected ':' at position 5"],
+      ['[tru]', 'Unexpected token at position 1'],
+      ['"\\x"', 'Invalid escape at position 2'],
+      ['[1] 2', 'Unexpected token after JSON value at position 4'],
+      ['', 'Unexpected end of input at position 0'],
+    ];
+    for (const [text, message] of cases) {
+      const err = await parseError(text);
+      expect(err instanceof SyntaxError).toBe(true);
+      expect(String(err.message)).toContain(message);
+    }
+  });
+
+  it('accepts deep nesting up to the limit and rejects beyond it', async () => {
+    const nest = (depth: number) => '['.repeat(depth) + ']'.repeat(depth);
+    let value: any = await parseJSON(bytes(nest(1024)));
+    let depth = 0;
+    while (Array.isArray(value)) {
+      depth++;
+      value = value[0];
+    }
+    expect(depth).toBe(1024);
+
+    const err = await parseError(nest(1025));
+    expect(err instanceof SyntaxError).toBe(true);
+    expect(String(err.message)).toContain('Nesting too deep at position 1024');
+  });
+
+  it('parses numbers exactly as JSON.parse does', async () => {
+    const text =
+      '[0, -0, 0.1, 1e21, 1E-7, 12345678901234567890, 9007199254740993,' +
+      ' 1.7976931348623157e308, 5e-324, 1e400, -1e400, 123.456e-2]';
+    const parsed = await parseJSON(bytes(text));
+    const expected = JSON.parse(text);
+    expect(parsed.length).toBe(expected.length);
+    for (let i = 0; i < expected.length; i++) {
+      expect(Object.is(parsed[i], expected[i])).toBe(true);
+    }
+  });
+
+  it('decodes escapes, surrogate pairs and lone surrogates', async () => {
+    const text =
+      '["\\"\\\\\\/\\b\\f\\n\\r\\t", "\\u0041\\u00e9\\u20ac",' +
+      ' "\\ud83d\\ude00", "😀é", "\\ud800", "a\\udc00b",' +
+      ' "\\ud800\\u0041", {"k\\u00e9y": "v"}]';
+    const parsed = await parseJSON(bytes(text));
+    expect(parsed).toEqual(JSON.parse(text));
+    expect(parsed[2]).toBe('😀');
+    expect(parsed[4].charCodeAt(0)).toBe(0xd800);
+    expect(parsed[6]).toBe('\ud800A');
+    expect((await parseJSONLazy(bytes(text)))[7]['kéy']).toBe('v');
+  });
+
+  it('reads members of a lazy document on demand', async () => {
+    const text = JSON.stringify({
+      user: { name: 'n', roles: ['admin', 'dev'] },
+      count: 3,
+    });
+    const doc = await parseJSONLazy(bytes(text));
+    expect(doc.count).toBe(3);
+    expect(doc.user.name).toBe('n');
+    expect(doc.user.roles.length).toBe(2);
+    expect(Array.from(doc.user.roles)).toEqual(['admin', 'dev']);
+    expect(Object.keys(doc)).toEqual(['user', 'count']);
+    expect(doc.missing).toBe(undefined);
+    expect(doc.user.roles[2]).toBe(undefined);
+  });
+
+  it('returns the same value when a lazy member is read twice', async () => {
+    const text = JSON.stringify({
+      user: { name: 'nitro', tags: ['x'] },
+      title: 'héllo 😀',
+      n: 7,
+    });
+    const doc = await parseJSONLazy(bytes(text));
+    const user = doc.user;
+    expect(doc.user === user).toBe(true);
+    expect(doc.user.tags === user.tags).toBe(true);
+    expect(doc.title).toBe('héllo 😀');
+    expect(doc.title).toBe('héllo 😀');
+    expect(doc.n).toBe(7);
+    expect(doc.n).toBe(7);
+    // Reading siblings in between does not disturb cached members.
+    expect(user.name).toBe('nitro');
+    expect(Array.from(doc.user.tags)).toEqual(['x']);
+    expect(doc.user === user).toBe(true);
+  });
+});
@@ -1,6 +1,9 @@
 import React from 'react';
 import { View, Text, StyleSheet, ScrollView, Pressable } from 'react-native';
-import { TextDecoder as NitroTextDecoder } from 'react-native-nitro-text-decoder';
+import {
+  TextDecoder as NitroTextDecoder,
+  configureParallelDecode,
+} from 'react-native-nitro-text-decoder';
 import { theme } from '../theme';
 
 declare const performance: any;
@@ -32,6 +35,18 @@ const SHAPES: Shape[] = [
 ];
 const SIZES: Size[] = [64, 256, 1024, 4096, 16384, 65536];
 
+// Large-input comparison: single-threaded vs the multi-core decode path.
+type ParallelRow = {
+  shape: Shape;
+  sizeMB: number;
+  singleMs: number;
+  parallelMs: number;
+};
+const LARGE_SHAPES: Shape[] = ['mixed', '3byte', '4byte'];
+const LARGE_SIZES_MB = [1, 4, 16];
+const LARGE_ITERATIONS = 10;
+const PARALLEL_WORKERS = 3;
+
 const SHAPE_LABEL: Record<Shape, string> = {
   'ascii': 'ASCII',
   'mixed': 'Mixed (5%)',
@@ -41,7 +56,7 @@ const SHAPE_LABEL: Record<Shape, string> = {
   'bom+ascii': 'BOM + ASCII',
 };
 
-function makePayload(shape: Shape, size: Size): Uint8Array {
+function makePayload(shape: Shape, size: number): Uint8Array {
   const buf = new Uint8Array(size);
   let i = 0;
   if (shape === 'ascii') {
@@ -142,6 +157,44 @@ function timeNitro(
   return trimmedMean(samples);
 }
 
+// ms per decode, after one warm-up call.
+function timeLarge(decoder: NitroTextDecoder, payload: Uint8Array): number {
+  let sink = decoder.decode(payload).length;
+  const t0 = now();
+  for (let j = 0; j < LARGE_ITERATIONS; j++) {
+    sink += decoder.decode(payload).length;
+  }
+  const t1 = now();
+  if (sink < 0) console.log('unreachable');
+  return (t1 - t0) / LARGE_ITERATIONS;
+}
+
+async function runParallelBench(
+  onProgress: (msg: string) => void
+): Promise<ParallelRow[]> {
+  const rows: ParallelRow[] = [];
+  const dec = new NitroTextDecoder();
+  console.log(
+    '[TextDecoderBench] PARALLEL shape,size_mb,single_ms,parallel_ms,speedup'
+  );
+  for (const shape of LARGE_SHAPES) {
+    for (const sizeMB of LARGE_SIZES_MB) {
+      onProgress(`${SHAPE_LABEL[shape]} · ${sizeMB}MB · single vs parallel`);
+      const payload = makePayload(shape, sizeMB * 1024 * 1024);
+      configureParallelDecode({ workers: 0 });
+      const singleMs = timeLarge(dec, payload);
+      configureParallelDecode({ workers: PARALLEL_WORKERS });
+      const parallelMs = timeLarge(dec, payload);
+      rows.push({ shape, sizeMB, singleMs, parallelMs });
+      console.log(
+        `[TextDecoderBench] PARALLEL ${shape},${sizeMB},${singleMs.toFixed(2)},${parallelMs.toFixed(2)},${(singleMs / parallelMs).toFixed(2)}`
+      );
+      await new Promise((r) => setTimeout(r, 0));
+    }
+  }
+  return rows;
+}
+
 function sizeLabel(size: Size): string {
   if (size >= 1024) return `${size / 1024}KB`;
   return `${size}B`;
@@ -149,7 +202,11 @@ function sizeLabel(size: Size): string {
 
 async function runBench(
   onProgress: (msg: string) => void
-): Promise<{ rows: Row[]; totalMs: number }> {
+): Promise<{
+  rows: Row[];
+  parallelRows: ParallelRow[];
+  totalMs: number;
+}> {
   const rows: Row[] = [];
   const dec = new NitroTextDecoder();
   const tStart = now();
@@ -195,6 +252,8 @@ async function runBench(
     }
   }
 
+  const parallelRows = await runParallelBench(onProgress);
+
   const totalMs = now() - tStart;
   console.log(`[TextDecoderBench] done in ${(totalMs / 1000).toFixed(1)}s`);
   console.log(
@@ -206,11 +265,12 @@ async function runBench(
     );
   }
 
-  return { rows, totalMs };
+  return { rows, parallelRows, totalMs };
 }
 
 export function TextDecoderBenchmarkScreen() {
   const [rows, setRows] = React.useState<Row[] | null>(null);
+  const [parallelRows, setParallelRows] = React.useState<ParallelRow[]>([]);
   const [totalMs, setTotalMs] = React.useState<number | null>(null);
   const [running, setRunning] = React.useState(false);
   const [progress, setProgress] = React.useState<string>('');
@@ -223,8 +283,13 @@ export function TextDecoderBenchmarkScreen() {
     setProgress('Warming up…');
     try {
       await new Promise((r) => setTimeout(r, 50));
-      const { rows: out, totalMs: ms } = await runBench(setProgress);
+      const {
+        rows: out,
+        parallelRows: large,
+        totalMs: ms,
+      } = await runBench(setProgress);
       setRows(out);
+      setParallelRows(large);
       setTotalMs(ms);
       setProgress('');
     } finally {
@@ -326,6 +391,44 @@ export function TextDecoderBenchmarkScreen() {
               </View>
             ))}
 
+            <View style={styles.tableHeader}>
+              <Text style={[styles.cell, styles.shapeCell, styles.headerText]}>
+                Large input
+              </Text>
+              <Text style={[styles.cell, styles.sizeCell, styles.headerText]}>
+                Size
+              </Text>
+              <Text style={[styles.cell, styles.numCell, styles.headerText]}>
+                1 thread ms
+              </Text>
+              <Text style={[styles.cell, styles.numCell, styles.headerText]}>
+                parallel ms
+              </Text>
+              <Text style={[styles.cell, styles.numCell, styles.headerText]}>
+                speedup
+              </Text>
+            </View>
+
+            {parallelRows.map((r) => (
+              <View key={`par-${r.shape}-${r.sizeMB}`} style={styles.row}>
+                <Text style={[styles.cell, styles.shapeCell]}>
+                  {SHAPE_LABEL[r.shape]}
+                </Text>
+                <Text style={[styles.cell, styles.sizeCell]}>
+                  {r.sizeMB}MB
+                </Text>
+                <Text style={[styles.cell, styles.numCell]}>
+                  {r.singleMs.toFixed(2)}
+                </Text>
+                <Text style={[styles.cell, styles.numCell, styles.medCell]}>
+                  {r.parallelMs.toFixed(2)}
+                </Text>
+                <Text style={[styles.cell, styles.numCell, styles.mbCell]}>
+                  {(r.singleMs / r.parallelMs).toFixed(2)}×
+                </Text>
+              </View>
+            ))}
+
             <View style={styles.legend}>
               <Text style={styles.legendText}>
                 Screenshot this table, switch builds (stash/pop the C++ patch),
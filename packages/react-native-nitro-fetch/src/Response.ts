@@ -1,5 +1,10 @@
 import { NitroHeaders } from './Headers';
-import { stringToUTF8, utf8ToString } from './utf8';
+import {
+  createUTF8StreamDecoder,
+  parseJSONBytes,
+  stringToUTF8,
+  utf8ToString,
+} from './utf8';
 import { bytesToBlob } from './blob';
 import type { NitroHeader } from './NitroFetch.nitro';
 
@@ -21,9 +26,74 @@ export interface NitroResponseInit {
   bodyBytes?: ArrayBuffer;
   bodyString?: string;
   body?: ReadableStream<Uint8Array<ArrayBuffer>>;
+  // Body already decoded chunk by chunk (fetch with `stream: 'text'`).
+  textBody?: ReadableStream<string>;
   type?: ResponseType;
 }
 
+async function drainText(stream: ReadableStream<string>): Promise<string> {
+  const reader = stream.getReader();
+  let text = '';
+  while (true) {
+    const { done, value } = await reader.read();
+    if (done) return text;
+    text += value;
+  }
+}
+
+// Pull-based adapters between string and byte streams. highWaterMark 0 keeps
+// the source unread (and unlocked) until someone reads the adapter.
+function encodeTextStream(
+  source: ReadableStream<string>
+): ReadableStream<Uint8Array<ArrayBuffer>> {
+  let reader: ReadableStreamDefaultReader<string> | undefined;
+  return new ReadableStream<Uint8Array<ArrayBuffer>>(
+    {
+      async pull(controller) {
+        reader ??= source.getReader();
+        const { done, value } = await reader.read();
+        if (done) controller.close();
+        else controller.enqueue(stringToUTF8(value) as Uint8Array<ArrayBuffer>);
+      },
+      cancel(reason) {
+        return reader?.cancel(reason);
+      },
+    },
+    { highWaterMark: 0 }
+  );
+}
+
+function decodeByteStream(
+  source: ReadableStream<Uint8Array<ArrayBuffer>> | null
+): ReadableStream<string> {
+  const decode =
+    createUTF8StreamDecoder() ??
+    ((chunk?: Uint8Array) => (chunk ? utf8ToString(chunk) : ''));
+  let reader: ReadableStreamDefaultReader<Uint8Array<ArrayBuffer>> | undefined;
+  return new ReadableStream<string>(
+    {
+      async pull(controller) {
+        if (source) {
+          reader ??= source.getReader();
+          const { done, value } = await reader.read();
+          if (!done) {
+            const text = value ? decode(value) : '';
+            if (text.length > 0) controller.enqueue(text);
+            return;
+          }
+        }
+        const tail = decode();
+        if (tail.length > 0) controller.enqueue(tail);
+        controller.close();
+      },
+      cancel(reason) {
+        return reader?.cancel(reason);
+      },
+    },
+    { highWaterMark: 0 }
+  );
+}
+
 function isNitroResponseInit(arg: any): arg is NitroResponseInit {
   return (
     arg != null &&
@@ -46,6 +116,7 @@ export class NitroResponse {
   private _bodyBytes: ArrayBuffer | undefined;
   private _bodyString: string | undefined;
   private _bodyStream: ReadableStream<Uint8Array<ArrayBuffer>> | undefined;
+  private _textStream: ReadableStream<string> | undefined;
   private _bodyUsed: boolean = false;
 
   constructor(body?: BodyInit | null, init?: ResponseInit);
@@ -73,6 +144,11 @@ export class NitroResponse {
       this._bodyBytes = nitroInit.bodyBytes;
       this._bodyString = nitroInit.bodyString;
       this._bodyStream = nitroInit.body;
+      this._textStream = nitroInit.textBody;
+      if (this._textStream) {
+        // Byte readers (body, arrayBuffer(), blob()) re-encode on demand.
+        this._bodyStream = encodeTextStream(this._textStream);
+      }
     } else {
       // Public constructor: new Response(body?, init?)
       const body = bodyOrInit as BodyInit | null | undefined;
@@ -149,6 +225,13 @@ export class NitroResponse {
     if (this._bodyBytes != null) return this._bodyBytes;
     if (this._bodyString != null) {
       const encoded = stringToUTF8(this._bodyString);
+      // The native encoder hands back an exactly-sized buffer; skip the copy.
+      if (
+        encoded.byteOffset === 0 &&
+        encoded.byteLength === encoded.buffer.byteLength
+      ) {
+        return encoded.buffer as ArrayBuffer;
+      }
       return (encoded.buffer as ArrayBuffer).slice(
         encoded.byteOffset,
         encoded.byteOffset + encoded.byteLength
@@ -165,9 +248,24 @@ export class NitroResponse {
     return '';
   }
 
+  /**
+   * Non-standard: the body as a stream of decoded strings. After
+   * `fetch(url, { stream: 'text' })` the chunks were decoded as they arrived;
+   * otherwise the body bytes are decoded chunk by chunk here.
+   */
+  textStream(): ReadableStream<string> {
+    this._throwIfBodyUsed();
+    this._bodyUsed = true;
+    if (this._textStream && !this._textStream.locked) return this._textStream;
+    return decodeByteStream(this.body);
+  }
+
   async text(): Promise<string> {
     this._throwIfBodyUsed();
     this._bodyUsed = true;
+    if (this._textStream && !this._textStream.locked) {
+      return drainText(this._textStream);
+    }
     if (this._bodyStream && !this._bodyBytes && this._bodyString == null) {
       const reader = this._bodyStream.getReader();
       const chunks: Uint8Array[] = [];
@@ -194,6 +292,16 @@ export class NitroResponse {
   async json(): Promise<any> {
     this._throwIfBodyUsed();
     this._bodyUsed = true;
+    if (this._textStream && !this._textStream.locked) {
+      return JSON.parse(await drainText(this._textStream));
+    }
+    if (
+      this._bodyString == null &&
+      this._bodyBytes != null &&
+      this._bodyBytes.byteLength > 0
+    ) {
+      return parseJSONBytes(this._bodyBytes);
+    }
     const t = this._getBodyString();
     return JSON.parse(t || '{}');
   }
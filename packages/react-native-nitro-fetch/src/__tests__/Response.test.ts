@@ -102,3 +102,72 @@ describe('NitroResponse — empty body', () => {
     expect(buf.byteLength).toBe(0);
   });
 });
+
+function streamOf<T>(chunks: T[]): ReadableStream<T> {
+  return new ReadableStream<T>({
+    start(controller) {
+      chunks.forEach((c) => controller.enqueue(c));
+      controller.close();
+    },
+  });
+}
+
+async function readAll(stream: ReadableStream<string>): Promise<string[]> {
+  const reader = stream.getReader();
+  const out: string[] = [];
+  for (let r = await reader.read(); !r.done; r = await reader.read()) {
+    out.push(r.value);
+  }
+  return out;
+}
+
+function makeStreamResponse(
+  init: Partial<{
+    body: ReadableStream<Uint8Array<ArrayBuffer>>;
+    textBody: ReadableStream<string>;
+  }>
+): NitroResponse {
+  return new NitroResponse({
+    url: 'https://example.com',
+    status: 200,
+    statusText: 'OK',
+    ok: true,
+    redirected: false,
+    headers: [],
+    ...init,
+  });
+}
+
+describe('NitroResponse — text streams', () => {
+  it('textStream() hands out pre-decoded chunks as they are', async () => {
+    const res = makeStreamResponse({ textBody: streamOf(['{"a":1}\n', 'é']) });
+    expect(await readAll(res.textStream())).toEqual(['{"a":1}\n', 'é']);
+    expect(res.bodyUsed).toBe(true);
+  });
+
+  it('text() and json() join a pre-decoded stream', async () => {
+    const res = makeStreamResponse({ textBody: streamOf(['{"v":', '42}']) });
+    expect(await res.json()).toEqual({ v: 42 });
+    const res2 = makeStreamResponse({ textBody: streamOf(['ab', 'ç']) });
+    expect(await res2.text()).toBe('abç');
+  });
+
+  it('arrayBuffer() re-encodes a pre-decoded stream', async () => {
+    const res = makeStreamResponse({ textBody: streamOf(['h', 'é']) });
+    const buf = await res.arrayBuffer();
+    expect(new Uint8Array(buf)).toEqual(new TextEncoder().encode('hé'));
+  });
+
+  it('textStream() decodes byte chunks, carrying split code points', async () => {
+    const bytes = new TextEncoder().encode('a€b');
+    const res = makeStreamResponse({
+      body: streamOf([bytes.slice(0, 2), bytes.slice(2, 4), bytes.slice(4)]),
+    });
+    expect((await readAll(res.textStream())).join('')).toBe('a€b');
+  });
+
+  it('textStream() on a buffered body yields the whole text', async () => {
+    const res = makeResponse({ bodyString: 'hello' });
+    expect(await readAll(res.textStream())).toEqual(['hello']);
+  });
+});
@@ -1,4 +1,4 @@
-import { utf8ToString } from './utf8';
+import { nativeBase64Encode, utf8ToString } from './utf8';
 
 // RN's Blob can't be built from an ArrayBuffer in JS. The NitroFetchBlob TurboModule
 // registers the bytes in RN's native Blob registry (RCTBlobManager / BlobModule) and
@@ -7,6 +7,7 @@ const B64 = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
 
 /* eslint-disable no-bitwise */
 export function base64FromBytes(bytes: Uint8Array): string {
+  if (nativeBase64Encode) return nativeBase64Encode(bytes);
   let out = '';
   for (let i = 0; i < bytes.length; i += 3) {
     const b0 = bytes[i] ?? 0;
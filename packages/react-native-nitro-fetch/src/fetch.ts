@@ -18,6 +18,11 @@ import { NitroRequest as NitroRequestClass, rawBodyOf } from './Request';
 import type { RequestRedirect, RequestCache } from './Request';
 import { NetworkInspector } from './NetworkInspector';
 import { base64FromBytes } from './blob';
+import {
+  createUTF8StreamDecoder,
+  nativeBase64Decode,
+  utf8ByteLength,
+} from './utf8';
 
 const TEXT_CONTENT_TYPE = 'text/plain;charset=UTF-8';
 const FORM_CONTENT_TYPE = 'application/x-www-form-urlencoded;charset=UTF-8';
@@ -505,6 +510,7 @@ function getUrlString(input: RequestInfo | URL): string {
 }
 
 function base64ToBytes(b64: string): Uint8Array {
+  if (nativeBase64Decode) return nativeBase64Decode(b64);
   const decode = (globalThis as { atob?: (s: string) => string }).atob;
   if (typeof decode === 'function') {
     const bin = decode(b64);
@@ -612,10 +618,7 @@ function decodeDataUrl(url: string): NitroResponseNative {
     if (decoded != null) bodyString = decoded;
   } else {
     bodyString = decodeURIComponent(rawData);
-    length =
-      typeof TextEncoder !== 'undefined'
-        ? new TextEncoder().encode(bodyString).length
-        : bodyString.length;
+    length = utf8ByteLength(bodyString);
   }
 
   return {
@@ -810,9 +813,17 @@ async function nitroStreamFetch(
   else if (normalized?.bodyString != null)
     builder.setUploadBody(normalized.bodyString);
 
+  // stream: 'text' fuses decoding into the read loop: each native chunk is
+  // decoded straight out of the callback's buffer (no slice) and only the
+  // string is enqueued; Response.textStream() hands those out.
+  const decodeChunk =
+    (init as { stream?: unknown } | undefined)?.stream === 'text'
+      ? createUTF8StreamDecoder()
+      : undefined;
+
   return new Promise((resolveResponse, rejectResponse) => {
     let streamController: ReadableStreamDefaultController<
-      Uint8Array<ArrayBuffer>
+      Uint8Array<ArrayBuffer> | string
     >;
     let abortListener: (() => void) | undefined;
 
@@ -822,7 +833,7 @@ async function nitroStreamFetch(
       abortListener = undefined;
     };
 
-    const stream = new ReadableStream<Uint8Array<ArrayBuffer>>({
+    const stream = new ReadableStream<Uint8Array<ArrayBuffer> | string>({
       start(controller) {
         streamController = controller;
       },
@@ -845,7 +856,9 @@ async function nitroStreamFetch(
         statusText: info.httpStatusText,
         headers: responseHeaders,
         redirected: false,
-        body: stream,
+        ...(decodeChunk
+          ? { textBody: stream as ReadableStream<string> }
+          : { body: stream as ReadableStream<Uint8Array<ArrayBuffer>> }),
       });
       resolveResponse(response as unknown as Response);
       // Android/Cronet: kick off the first buffer read.
@@ -855,9 +868,16 @@ async function nitroStreamFetch(
 
     builder.onReadCompleted((_info, byteBuffer, bytesRead) => {
       if (signal?.aborted) return;
-      const chunk = new Uint8Array(byteBuffer, 0, bytesRead).slice();
       streamBytesReceived += bytesRead;
-      streamController.enqueue(chunk);
+      if (decodeChunk) {
+        // Decoded before read() below lets native reuse the buffer.
+        const text = decodeChunk(new Uint8Array(byteBuffer, 0, bytesRead));
+        if (text.length > 0) streamController.enqueue(text);
+      } else {
+        streamController.enqueue(
+          new Uint8Array(byteBuffer, 0, bytesRead).slice()
+        );
+      }
       if (!request.isDone()) {
         request.read();
       }
@@ -865,6 +885,10 @@ async function nitroStreamFetch(
 
     builder.onSucceeded((_info) => {
       cleanupAbortListener();
+      if (decodeChunk) {
+        const tail = decodeChunk();
+        if (tail.length > 0) streamController.enqueue(tail);
+      }
       streamController.close();
       if (inspectorId) {
         const info = _info as any;
@@ -935,7 +959,8 @@ async function nitroStreamFetch(
 export async function nitroFetch(
   input: RequestInfo | URL,
   init?: RequestInit & {
-    stream?: boolean;
+    // 'text': stream the body as decoded strings (Response.textStream()).
+    stream?: boolean | 'text';
     redirect?: RequestRedirect;
     cache?: RequestCache;
   }
@@ -951,7 +976,11 @@ export async function nitroFetch(
   }
 
   // Streaming is http(s)-only; local URLs fall through to nitroFetchRaw (check runs only when streaming).
-  if ((init as any)?.stream === true && isHttpUrl(getUrlString(input))) {
+  const streamMode = (init as any)?.stream;
+  if (
+    (streamMode === true || streamMode === 'text') &&
+    isHttpUrl(getUrlString(input))
+  ) {
     init = await resolveRequestBody(input, init);
     init = await resolveBlobBody(init);
     return nitroStreamFetch(input, init);
@@ -50,7 +50,7 @@ export type TokenRefreshConfig = {
 export async function fetch(
   input: RequestInfo | URL,
   init?: RequestInit & {
-    stream?: boolean;
+    stream?: boolean | 'text';
     redirect?: RequestRedirect;
     cache?: RequestCache;
   }
@@ -3,37 +3,54 @@ let _TextDecoder: typeof TextDecoder | undefined;
 
 const NITRO_TEXT_DECODER_PKG = 'react-native-nitro-text-decoder';
 
-function loadOptionalTextCodec(): {
+type OptionalTextCodec = {
   TextEncoder?: typeof TextEncoder;
   TextDecoder?: typeof TextDecoder;
-} {
+  utf8Length?: (str: string) => number;
+  decodeUTF8?: (bytes: Uint8Array) => string;
+  parseJSON?: (bytes: ArrayBuffer) => Promise<any>;
+  base64Encode?: (bytes: Uint8Array) => string;
+  base64Decode?: (str: string) => Uint8Array;
+};
+
+function loadOptionalTextCodec(): OptionalTextCodec {
   try {
     // Hide require from the bundler so the package stays truly optional.
     // eslint-disable-next-line no-new-func
     const dynamicRequire = new Function('mod', 'return require(mod);') as (
       m: string
     ) => unknown;
-    return dynamicRequire(NITRO_TEXT_DECODER_PKG) as {
-      TextEncoder?: typeof TextEncoder;
-      TextDecoder?: typeof TextDecoder;
-    };
+    return dynamicRequire(NITRO_TEXT_DECODER_PKG) as OptionalTextCodec;
   } catch {
     return {};
   }
 }
 
-if (typeof TextEncoder !== 'undefined') {
+// Prefer the native (simdutf) encoder when the package is installed — it
+// beats the runtime's global TextEncoder on large request/response bodies.
+const _codec = loadOptionalTextCodec();
+const _utf8Length = _codec.utf8Length;
+const _decodeUTF8 = _codec.decodeUTF8;
+const _parseJSON = _codec.parseJSON;
+
+// simdutf base64 from the native package, when installed.
+export const nativeBase64Encode = _codec.base64Encode;
+export const nativeBase64Decode = _codec.base64Decode;
+if (_codec.TextEncoder) {
+  _TextEncoder = _codec.TextEncoder;
+} else if (typeof TextEncoder !== 'undefined') {
   _TextEncoder = TextEncoder;
-} else {
-  _TextEncoder = loadOptionalTextCodec().TextEncoder;
 }
 
 if (typeof TextDecoder !== 'undefined') {
   _TextDecoder = TextDecoder;
 } else {
-  _TextDecoder = loadOptionalTextCodec().TextDecoder;
+  _TextDecoder = _codec.TextDecoder;
 }
 
+// TextEncoder is stateless; reuse one instance across calls.
+let _encoder: TextEncoder | undefined;
+
 export function stringToUTF8(str: string): Uint8Array {
   if (!_TextEncoder) {
     console.warn(
@@ -41,10 +58,19 @@ export function stringToUTF8(str: string): Uint8Array {
     );
     return new Uint8Array(0);
   }
-  return new _TextEncoder().encode(str);
+  if (!_encoder) _encoder = new _TextEncoder();
+  return _encoder.encode(str);
+}
+
+export function utf8ByteLength(str: string): number {
+  if (_utf8Length) return _utf8Length(str);
+  if (_TextEncoder) return stringToUTF8(str).byteLength;
+  return str.length;
 }
 
 export function utf8ToString(bytes: Uint8Array): string {
+  // Stateless native decode: no TextDecoder allocated per body.
+  if (_decodeUTF8) return _decodeUTF8(bytes);
   if (!_TextDecoder) {
     console.warn(
       'utf8ToString: TextDecoder not available. Install react-native-nitro-text-decoder.'
@@ -53,3 +79,25 @@ export function utf8ToString(bytes: Uint8Array): string {
   }
   return new _TextDecoder().decode(bytes);
 }
+
+const STREAM_OPTIONS = { stream: true };
+
+// Incremental UTF-8 decode of a chunked body: call with each chunk, then with
+// no argument to flush. A code point split across chunks is carried over
+// (in C++ with the native package).
+export type UTF8StreamDecoder = (chunk?: Uint8Array) => string;
+
+export function createUTF8StreamDecoder(): UTF8StreamDecoder | undefined {
+  const Decoder = _codec.TextDecoder ?? _TextDecoder;
+  if (!Decoder) return undefined;
+  const decoder = new Decoder();
+  return (chunk) =>
+    chunk ? decoder.decode(chunk, STREAM_OPTIONS) : decoder.decode();
+}
+
+// JSON.parse over a UTF-8 body. With the native package installed the bytes
+// are parsed off the JS thread and never become an intermediate string.
+export async function parseJSONBytes(bytes: ArrayBuffer): Promise<any> {
+  if (_parseJSON) return _parseJSON(bytes);
+  return JSON.parse(utf8ToString(new Uint8Array(bytes)));
+}
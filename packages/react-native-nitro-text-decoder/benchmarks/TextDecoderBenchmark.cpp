@@ -0,0 +1,318 @@
+/*
+ * Throughput benchmarks for the text-decoder engine (see README.md).
+ *
+ * Everything here runs the JSI-free building blocks of
+ * HybridTextDecoder::decodeChunk directly, so results are comparable across
+ * machines and releases without a device.
+ */
+
+#include "ParallelUTF8.hpp"
+#include "TextDecoderUtils.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "simdutf.h"
+
+using namespace margelo::nitro::nitrotextdecoder;
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Corpora
+// ---------------------------------------------------------------------------
+
+struct Corpus {
+  const char *name;
+  std::vector<const char *> pieces;
+  // Insert one ill-formed byte roughly every this many bytes (0 = never).
+  size_t invalidEvery;
+};
+
+const std::vector<Corpus> &corpora() {
+  static const std::vector<Corpus> all = {
+      {"ascii", {"{\"id\":1234,", "\"name\":\"nitro\",", " lorem ipsum ", "\n"}, 0},
+      {"latin1",
+       {"caf\xC3\xA9 ", "na\xC3\xAFve ", "\xC3\x86r\xC3\xB8sk\xC3\xB8""bing ",
+        "Stra\xC3\x9F""e ", "\xC3\xA0 la ", "ok "},
+       0},
+      {"cjk",
+       {"\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E", "\xE4\xB8\xAD\xE6\x96\x87",
+        "\xED\x95\x9C\xEA\xB5\xAD\xEC\x96\xB4", "\xE3\x80\x82", " "},
+       0},
+      {"emoji",
+       {"\xF0\x9F\x98\x80", "\xF0\x9F\x9A\x80", "\xF0\x9F\x91\x8D\xF0\x9F\x8F\xBD",
+        " hi "},
+       0},
+      {"invalid",
+       {"{\"id\":1234,", "caf\xC3\xA9 ", "\xE6\x97\xA5\xE6\x9C\xAC", " text "},
+       512},
+  };
+  return all;
+}
+
+std::vector<uint8_t> makeCorpus(const Corpus &corpus, size_t size) {
+  std::mt19937 rng(42);
+  std::string out;
+  out.reserve(size + 16);
+  size_t nextInvalid = corpus.invalidEvery;
+  while (out.size() < size) {
+    out += corpus.pieces[rng() % corpus.pieces.size()];
+    if (corpus.invalidEvery != 0 && out.size() >= nextInvalid) {
+      static const char *bad[] = {"\x80", "\xC3", "\xED\xA0\x80", "\xF0\x9F"};
+      out += bad[rng() % 4];
+      nextInvalid += corpus.invalidEvery;
+    }
+  }
+  // Cut back to a code point boundary so valid corpora stay valid.
+  size_t end = size;
+  while (end > 0 && (static_cast<uint8_t>(out[end]) & 0xC0) == 0x80) --end;
+  out.resize(end);
+  return std::vector<uint8_t>(out.begin(), out.end());
+}
+
+std::vector<char16_t> &utf16Buffer(size_t units) {
+  static std::vector<char16_t> buf;
+  if (buf.size() < units) buf.resize(units);
+  return buf;
+}
+
+// ---------------------------------------------------------------------------
+// Decode paths
+// ---------------------------------------------------------------------------
+
+// What decodeChunk does for a non-streaming UTF-8 chunk of `length` bytes
+// that is at least kSimdMinBytes long: ASCII scan, simdutf validation, then
+// either the valid transcode or the single-pass replacement transcode.
+size_t simdutfDecode(const uint8_t *bytes, size_t length, char16_t *out) {
+  size_t asciiLen = findASCIIPrefixLength(bytes, length);
+  if (asciiLen == length) {
+    // decodeChunk hands pure ASCII to createFromAscii without transcoding.
+    return length;
+  }
+  auto validation = simdutf::validate_utf8_with_errors(
+      reinterpret_cast<const char *>(bytes + asciiLen), length - asciiLen);
+  if (asciiLen + validation.count == length) {
+    return simdutf::convert_valid_utf8_to_utf16le(
+        reinterpret_cast<const char *>(bytes), length, out);
+  }
+  return convertUTF8ToUTF16WithReplacement(bytes, length, out);
+}
+
+// Scalar UTF-8 -> UTF-16 in the style of Hermes' createFromUtf8, i.e. what
+// chunks below kSimdMinBytes pay instead of simdutfDecode.
+size_t scalarDecode(const uint8_t *bytes, size_t length, char16_t *out) {
+  size_t i = 0;
+  size_t written = 0;
+  while (i < length) {
+    uint8_t c = bytes[i];
+    if (c < 0x80) {
+      out[written++] = c;
+      ++i;
+      continue;
+    }
+    unsigned seqLen = validUTF8SequenceLength(c);
+    if (seqLen == 0 || i + seqLen > length) {
+      out[written++] = static_cast<char16_t>(UNICODE_REPLACEMENT_CHARACTER);
+      ++i;
+      continue;
+    }
+    char32_t cp = decodeUTF8CodePoint(bytes + i, seqLen);
+    if (cp > 0xFFFF) {
+      out[written++] = static_cast<char16_t>(0xD7C0 + (cp >> 10));
+      out[written++] = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+    } else {
+      out[written++] = static_cast<char16_t>(cp);
+    }
+    i += seqLen;
+  }
+  return written;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+void BM_FindValidUTF8RunLength(benchmark::State &state, const Corpus *corpus) {
+  auto data = makeCorpus(*corpus, static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    size_t i = 0;
+    while (i < data.size()) {
+      size_t run = findValidUTF8RunLength(data.data() + i, data.size() - i);
+      i += run > 0 ? run : 1;
+    }
+    benchmark::DoNotOptimize(i);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(data.size()));
+}
+
+void BM_Simdutf(benchmark::State &state, const Corpus *corpus) {
+  auto data = makeCorpus(*corpus, static_cast<size_t>(state.range(0)));
+  char16_t *out = utf16Buffer(data.size()).data();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(simdutfDecode(data.data(), data.size(), out));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(data.size()));
+}
+
+void BM_DecodeUTF8Fallback(benchmark::State &state, const Corpus *corpus) {
+  auto data = makeCorpus(*corpus, static_cast<size_t>(state.range(0)));
+  std::string decoded;
+  for (auto _ : state) {
+    decoded.clear();
+    uint8_t pending[4];
+    size_t pendingCount = 0;
+    bool bomSeen = false;
+    decodeUTF8(data.data(), data.size(), /*fatal*/ false, /*ignoreBOM*/ true,
+               /*stream*/ false, /*bomSeen*/ false, &decoded, pending,
+               &pendingCount, &bomSeen);
+    benchmark::DoNotOptimize(decoded.data());
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(data.size()));
+}
+
+// 4 MiB delivered in chunks of state.range(0) bytes, carrying a split code
+// point into the next chunk the way decodeChunk does in stream mode.
+void BM_Streaming(benchmark::State &state, const Corpus *corpus) {
+  constexpr size_t kTotal = 4 << 20;
+  auto data = makeCorpus(*corpus, kTotal);
+  size_t chunk = static_cast<size_t>(state.range(0));
+  std::vector<uint8_t> joined(chunk + 4);
+  char16_t *out = utf16Buffer(chunk + 4).data();
+  for (auto _ : state) {
+    size_t pending = 0;
+    size_t units = 0;
+    for (size_t at = 0; at < data.size(); at += chunk) {
+      size_t n = std::min(chunk, data.size() - at);
+      const uint8_t *bytes = data.data() + at;
+      if (pending > 0) {
+        std::memcpy(joined.data() + pending, bytes, n);
+        bytes = joined.data();
+        n += pending;
+      }
+      size_t tail = incompleteUTF8TailLength(bytes, n);
+      size_t body = n - tail;
+      units += body < kSimdMinBytes ? scalarDecode(bytes, body, out)
+                                    : simdutfDecode(bytes, body, out);
+      std::memmove(joined.data(), bytes + body, tail);
+      pending = tail;
+    }
+    benchmark::DoNotOptimize(units);
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(data.size()));
+}
+
+// The kSimdMinBytes crossover: below it decodeChunk hands bytes to the
+// runtime's scalar transcoder; above it, simdutf.
+void BM_SmallScalar(benchmark::State &state, const Corpus *corpus) {
+  auto data = makeCorpus(*corpus, static_cast<size_t>(state.range(0)));
+  char16_t *out = utf16Buffer(data.size() * 2).data();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scalarDecode(data.data(), data.size(), out));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(data.size()));
+}
+
+// Single-threaded vs ParallelUTF8Decode with state.range(1) workers.
+void BM_Parallel(benchmark::State &state, const Corpus *corpus) {
+  auto data = makeCorpus(*corpus, static_cast<size_t>(state.range(0)));
+  char16_t *out = utf16Buffer(data.size()).data();
+  setParallelDecodeWorkers(static_cast<size_t>(state.range(1)));
+  for (auto _ : state) {
+    ParallelUTF8Decode parallel;
+    if (parallel.validate(data.data(), data.size()) &&
+        !parallel.convert(out)) {
+      state.SkipWithError("parallel convert wrote a different length");
+      break;
+    }
+    benchmark::DoNotOptimize(parallel.utf16Length());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          static_cast<int64_t>(data.size()));
+}
+
+// What the first simdutf call of a process pays on top of the kernel:
+// picking the implementation (CPUID on x86; nothing on arm64, which only
+// compiles NEON). simdutf has no static initializers, so loading the
+// library costs nothing until then.
+void BM_DetectImplementation(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        simdutf::get_available_implementations().detect_best_supported());
+  }
+}
+
+// Must run before anything else touches simdutf.
+void recordFirstCall() {
+  auto start = std::chrono::steady_clock::now();
+  bool valid = simdutf::validate_utf8("", 0);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  benchmark::DoNotOptimize(valid);
+  benchmark::AddCustomContext(
+      "simdutf_implementation",
+      std::string(simdutf::get_active_implementation()->name()));
+  benchmark::AddCustomContext(
+      "simdutf_first_call_ns",
+      std::to_string(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count()));
+}
+
+void registerAll() {
+  benchmark::RegisterBenchmark("DetectImplementation",
+                               BM_DetectImplementation);
+  for (const Corpus &corpus : corpora()) {
+    std::string name = corpus.name;
+    const Corpus *c = &corpus;
+    for (auto [label, fn] :
+         {std::pair{"FindValidUTF8RunLength", &BM_FindValidUTF8RunLength},
+          std::pair{"Simdutf", &BM_Simdutf},
+          std::pair{"DecodeUTF8Fallback", &BM_DecodeUTF8Fallback}}) {
+      benchmark::RegisterBenchmark((std::string(label) + "/" + name).c_str(),
+                                   fn, c)
+          ->RangeMultiplier(16)
+          ->Range(64, 1 << 20);
+    }
+    benchmark::RegisterBenchmark(("Streaming/" + name).c_str(), BM_Streaming,
+                                 c)
+        ->RangeMultiplier(4)
+        ->Range(64, 1 << 20);
+    for (auto [label, fn] : {std::pair{"SmallScalar", &BM_SmallScalar},
+                             std::pair{"SmallSimdutf", &BM_Simdutf}}) {
+      auto *b = benchmark::RegisterBenchmark(
+          (std::string(label) + "/" + name).c_str(), fn, c);
+      for (int64_t size = 16; size <= 1024; size *= 2) b->Arg(size);
+    }
+    if (corpus.invalidEvery == 0) {
+      benchmark::RegisterBenchmark(("Parallel/" + name).c_str(), BM_Parallel,
+                                   c)
+          ->ArgsProduct({{1 << 20, 4 << 20, 16 << 20}, {0, 1, 3}})
+          ->UseRealTime();
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  recordFirstCall();
+  registerAll();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
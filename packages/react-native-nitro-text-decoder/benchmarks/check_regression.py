@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON reports by throughput.
+
+    check_regression.py base.json head.json [--threshold 0.15]
+
+Exits non-zero if any benchmark present in both reports lost more than
+`threshold` of its bytes_per_second. Uses the median aggregate when the runs
+were repeated (--benchmark_repetitions), the plain result otherwise.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    plain, medians = {}, {}
+    for b in report["benchmarks"]:
+        if "bytes_per_second" not in b:
+            continue
+        if b.get("aggregate_name") == "median":
+            medians[b["run_name"]] = b["bytes_per_second"]
+        elif b.get("run_type", "iteration") == "iteration":
+            plain.setdefault(b.get("run_name", b["name"]), b["bytes_per_second"])
+    return medians or plain
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("base")
+    parser.add_argument("head")
+    parser.add_argument("--threshold", type=float, default=0.15)
+    args = parser.parse_args()
+
+    base, head = load(args.base), load(args.head)
+    regressions = []
+    for name in sorted(base.keys() & head.keys()):
+        change = head[name] / base[name] - 1
+        marker = ""
+        if change < -args.threshold:
+            regressions.append(name)
+            marker = "  <-- regression"
+        print(f"{name:60} {base[name] / 1e6:10.1f} -> "
+              f"{head[name] / 1e6:10.1f} MB/s {change:+7.1%}{marker}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower by more than "
+              f"{args.threshold:.0%}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
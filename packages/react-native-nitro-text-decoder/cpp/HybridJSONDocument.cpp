@@ -0,0 +1,364 @@
+/*
+ * Parsed JSON document for Nitro: holds a JSONTape built off the JS thread
+ * and turns it into JS values on demand.
+ */
+
+#include "HybridJSONDocument.hpp"
+
+#include <NitroModules/HybridObject.hpp>
+#include <NitroModules/JSICache.hpp>
+
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::nitrotextdecoder {
+using namespace margelo::nitro;
+
+namespace {
+
+// Generalized UTF-8 (escaped lone surrogates) -> UTF-16.
+std::u16string wtf8ToUTF16(const char *data, size_t length) {
+  std::u16string out;
+  out.reserve(length);
+  const auto *p = reinterpret_cast<const uint8_t *>(data);
+  const uint8_t *end = p + length;
+  while (p < end) {
+    uint32_t cp;
+    if (p[0] < 0x80) {
+      cp = *p++;
+    } else if (p[0] < 0xE0) {
+      cp = ((p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+      p += 2;
+    } else if (p[0] < 0xF0) {
+      cp = ((p[0] & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+      p += 3;
+    } else {
+      cp = ((p[0] & 0x07) << 18) | ((p[1] & 0x3F) << 12) |
+           ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+      p += 4;
+    }
+    if (cp >= 0x10000) {
+      out.push_back(static_cast<char16_t>(0xD7C0 + (cp >> 10)));
+      out.push_back(static_cast<char16_t>(0xDC00 + (cp & 0x3FF)));
+    } else {
+      out.push_back(static_cast<char16_t>(cp));
+    }
+  }
+  return out;
+}
+
+jsi::String makeString(jsi::Runtime &runtime, const JSONTape::StringRef &s) {
+  if (s.ascii) {
+    return jsi::String::createFromAscii(runtime, s.data, s.length);
+  }
+  if (s.wtf8) [[unlikely]] {
+    std::u16string units = wtf8ToUTF16(s.data, s.length);
+    return jsi::String::createFromUtf16(runtime, units.data(), units.size());
+  }
+  return jsi::String::createFromUtf8(
+      runtime, reinterpret_cast<const uint8_t *>(s.data), s.length);
+}
+
+jsi::PropNameID makeKeyName(jsi::Runtime &runtime, const JSONTape &tape,
+                            uint32_t keyId) {
+  JSONTape::StringRef key = tape.key(keyId);
+  if (key.ascii) {
+    return jsi::PropNameID::forAscii(runtime, key.data, key.length);
+  }
+  return jsi::PropNameID::forString(runtime, makeString(runtime, key));
+}
+
+// Numbers and literals; strings and containers are handled by the callers.
+jsi::Value makeScalar(const JSONTape &tape, size_t index) {
+  switch (tape.tag(index)) {
+  case 'd':
+    return jsi::Value(tape.number(index));
+  case 't':
+    return jsi::Value(true);
+  case 'f':
+    return jsi::Value(false);
+  default:
+    return jsi::Value::null();
+  }
+}
+
+// One linear walk over the tape. Each distinct key gets a single PropNameID,
+// created the first time it is needed.
+class Materializer {
+public:
+  Materializer(jsi::Runtime &runtime, const JSONTape &tape)
+      : _runtime(runtime), _tape(tape), _keys(tape.keyCount()) {
+    for (uint32_t id = 0; id < tape.keyCount(); ++id) {
+      JSONTape::StringRef key = tape.key(id);
+      if (key.length == 9 && std::memcmp(key.data, "__proto__", 9) == 0) {
+        _protoKey = id;
+      }
+    }
+  }
+
+  jsi::Value build(size_t &index) {
+    size_t at = index;
+    switch (_tape.tag(at)) {
+    case '{': {
+      jsi::Object object(_runtime);
+      size_t end = _tape.after(at) - 1;
+      index = at + 1;
+      while (index < end) {
+        auto keyId = static_cast<uint32_t>(_tape.payload(index));
+        ++index;
+        jsi::Value value = build(index);
+        if (keyId == _protoKey) [[unlikely]] {
+          defineOwn(object, keyId, std::move(value));
+        } else {
+          object.setProperty(_runtime, propName(keyId), std::move(value));
+        }
+      }
+      index = end + 1;
+      return object;
+    }
+    case '[': {
+      size_t count = _tape.count(at);
+      if (count == JSONTape::kMaxCount) [[unlikely]] {
+        count = 0;
+        for (size_t i = at + 1; i < _tape.after(at) - 1; i = _tape.next(i)) {
+          ++count;
+        }
+      }
+      jsi::Array array(_runtime, count);
+      index = at + 1;
+      for (size_t i = 0; i < count; ++i) {
+        array.setValueAtIndex(_runtime, i, build(index));
+      }
+      index = _tape.after(at);
+      return array;
+    }
+    case '"':
+      index = at + 1;
+      return makeString(_runtime, _tape.string(at));
+    default:
+      index = _tape.next(at);
+      return makeScalar(_tape, at);
+    }
+  }
+
+private:
+  const jsi::PropNameID &propName(uint32_t keyId) {
+    std::optional<jsi::PropNameID> &slot = _keys[keyId];
+    if (!slot.has_value()) {
+      slot.emplace(makeKeyName(_runtime, _tape, keyId));
+    }
+    return *slot;
+  }
+
+  // JSON.parse creates an own "__proto__" property; a plain set would hit
+  // the Object.prototype setter and swap the prototype instead.
+  void defineOwn(jsi::Object &object, uint32_t keyId, jsi::Value value) {
+    jsi::Object descriptor(_runtime);
+    descriptor.setProperty(_runtime, "value", std::move(value));
+    descriptor.setProperty(_runtime, "writable", true);
+    descriptor.setProperty(_runtime, "enumerable", true);
+    descriptor.setProperty(_runtime, "configurable", true);
+    jsi::Function defineProperty =
+        _runtime.global()
+            .getPropertyAsObject(_runtime, "Object")
+            .getPropertyAsFunction(_runtime, "defineProperty");
+    defineProperty.call(_runtime, object,
+                        makeString(_runtime, _tape.key(keyId)), descriptor);
+  }
+
+  jsi::Runtime &_runtime;
+  const JSONTape &_tape;
+  std::vector<std::optional<jsi::PropNameID>> _keys;
+  uint32_t _protoKey = UINT32_MAX;
+};
+
+// Read-only view of one object or array on the tape. Members are located
+// on first access; strings and nested views are cached per child so
+// repeated reads hand back the same JS value. The cache holds them through
+// the runtime's JSICache, so a node finalized during runtime teardown does
+// not release values of a runtime that is already gone.
+class JSONLazyNode : public jsi::HostObject {
+public:
+  JSONLazyNode(std::shared_ptr<const JSONTape> tape, size_t index)
+      : _tape(std::move(tape)), _index(index),
+        _isArray(_tape->tag(index) == '[') {}
+
+  jsi::Value get(jsi::Runtime &runtime,
+                 const jsi::PropNameID &name) override {
+    std::string key = name.utf8(runtime);
+    ensureChildren();
+    size_t slot;
+    if (_isArray) {
+      if (key == "length") {
+        return jsi::Value(static_cast<double>(_children.size()));
+      }
+      if (!parseIndex(key, &slot)) return jsi::Value::undefined();
+    } else {
+      uint32_t keyId;
+      if (!_tape->findKey(key.data(), key.size(), &keyId)) {
+        return jsi::Value::undefined();
+      }
+      auto it = _slotByKey.find(keyId);
+      if (it == _slotByKey.end()) return jsi::Value::undefined();
+      slot = it->second;
+    }
+    return childValue(runtime, slot);
+  }
+
+  std::vector<jsi::PropNameID>
+  getPropertyNames(jsi::Runtime &runtime) override {
+    ensureChildren();
+    std::vector<jsi::PropNameID> names;
+    names.reserve(_children.size());
+    if (_isArray) {
+      for (size_t i = 0; i < _children.size(); ++i) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, std::to_string(i)));
+      }
+    } else {
+      for (uint32_t keyId : _keyIds) {
+        names.push_back(makeKeyName(runtime, *_tape, keyId));
+      }
+    }
+    return names;
+  }
+
+private:
+  void ensureChildren() {
+    if (_indexed) return;
+    _indexed = true;
+    size_t end = _tape->after(_index) - 1;
+    size_t i = _index + 1;
+    while (i < end) {
+      if (_isArray) {
+        _children.push_back(i);
+        i = _tape->next(i);
+        continue;
+      }
+      // As with JSON.parse, a repeated key keeps its first position and
+      // takes the last value.
+      auto keyId = static_cast<uint32_t>(_tape->payload(i));
+      auto [it, inserted] = _slotByKey.try_emplace(keyId, _children.size());
+      if (inserted) {
+        _children.push_back(i + 1);
+        _keyIds.push_back(keyId);
+      } else {
+        _children[it->second] = i + 1;
+      }
+      i = _tape->next(i + 1);
+    }
+    _cache.resize(_children.size());
+  }
+
+  bool parseIndex(const std::string &key, size_t *slot) const {
+    if (key.empty() || key.size() > 10 || (key.size() > 1 && key[0] == '0')) {
+      return false;
+    }
+    size_t value = 0;
+    for (char c : key) {
+      if (c < '0' || c > '9') return false;
+      value = value * 10 + static_cast<size_t>(c - '0');
+    }
+    if (value >= _children.size()) return false;
+    *slot = value;
+    return true;
+  }
+
+  jsi::Value childValue(jsi::Runtime &runtime, size_t slot) {
+    BorrowingReference<jsi::Value> &cached = _cache[slot];
+    if (cached) return jsi::Value(runtime, *cached);
+    size_t at = _children[slot];
+    jsi::Value value;
+    switch (_tape->tag(at)) {
+    case '{':
+    case '[':
+      value = jsi::Object::createFromHostObject(
+          runtime, std::make_shared<JSONLazyNode>(_tape, at));
+      break;
+    case '"':
+      value = makeString(runtime, _tape->string(at));
+      break;
+    default:
+      return makeScalar(*_tape, at);
+    }
+    cached = JSICache::getOrCreateCache(runtime).makeShared(
+        jsi::Value(runtime, value));
+    return value;
+  }
+
+  std::shared_ptr<const JSONTape> _tape;
+  size_t _index;
+  bool _isArray;
+  bool _indexed = false;
+  // Tape index of each element (arrays) or member value (objects).
+  std::vector<size_t> _children;
+  std::vector<uint32_t> _keyIds;
+  std::unordered_map<uint32_t, size_t> _slotByKey;
+  std::vector<BorrowingReference<jsi::Value>> _cache;
+};
+
+} // namespace
+
+HybridJSONDocument::HybridJSONDocument(size_t byteLength)
+    : HybridObject(TAG), _byteLength(byteLength),
+      _tape(std::make_shared<JSONTape>()) {}
+
+HybridJSONDocument::~HybridJSONDocument() = default;
+
+double HybridJSONDocument::getByteLength() {
+  return static_cast<double>(_byteLength);
+}
+
+void HybridJSONDocument::parse(const uint8_t *bytes, size_t length) {
+  _tape->parse(bytes, length);
+}
+
+size_t HybridJSONDocument::getExternalMemorySize() noexcept {
+  return _tape->memorySize();
+}
+
+void HybridJSONDocument::loadHybridMethods() {
+  HybridObject::loadHybridMethods();
+  registerHybrids(this, [](Prototype &proto) {
+    proto.registerHybridGetter("byteLength",
+                               &HybridJSONDocument::getByteLength);
+    proto.registerRawHybridMethod("materialize", 0,
+                                  &HybridJSONDocument::materializeRaw);
+    proto.registerRawHybridMethod("lazy", 0, &HybridJSONDocument::lazyRaw);
+  });
+}
+
+// Raw JSI materialize. Signature: materialize() -> any.
+jsi::Value HybridJSONDocument::materializeRaw(jsi::Runtime &runtime,
+                                              const jsi::Value & /*thisVal*/,
+                                              const jsi::Value * /*args*/,
+                                              size_t /*count*/) {
+  if (_tape->size() == 0) [[unlikely]] {
+    throw jsi::JSError(runtime, "JSON document is empty");
+  }
+  size_t index = 0;
+  return Materializer(runtime, *_tape).build(index);
+}
+
+// Raw JSI lazy. Signature: lazy() -> any. Objects and arrays come back as
+// HostObject views that share the tape; primitives are returned as is.
+jsi::Value HybridJSONDocument::lazyRaw(jsi::Runtime &runtime,
+                                       const jsi::Value & /*thisVal*/,
+                                       const jsi::Value * /*args*/,
+                                       size_t /*count*/) {
+  if (_tape->size() == 0) [[unlikely]] {
+    throw jsi::JSError(runtime, "JSON document is empty");
+  }
+  char tag = _tape->tag(0);
+  if (tag == '{' || tag == '[') {
+    return jsi::Object::createFromHostObject(
+        runtime, std::make_shared<JSONLazyNode>(_tape, 0));
+  }
+  size_t index = 0;
+  return Materializer(runtime, *_tape).build(index);
+}
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -0,0 +1,56 @@
+/*
+ * Parsed JSON document for Nitro: holds a JSONTape built off the JS thread
+ * and turns it into JS values on demand.
+ */
+
+#pragma once
+
+#include "HybridNitroJSONDocumentSpec.hpp"
+#include "JSONTape.hpp"
+
+#include <cstdint>
+#include <jsi/jsi.h>
+#include <memory>
+
+namespace margelo::nitro::nitrotextdecoder {
+
+namespace jsi = facebook::jsi;
+
+/**
+ * C++ implementation of the `NitroJSONDocument` interface.
+ * Created by `NitroTextEncoding.parseJSON()`. Two raw JSI methods read it:
+ * `materialize()` builds the whole JS value in one pass over the tape, and
+ * `lazy()` returns read-only HostObject views that convert on access.
+ */
+class HybridJSONDocument : public HybridNitroJSONDocumentSpec {
+public:
+  explicit HybridJSONDocument(size_t byteLength);
+  ~HybridJSONDocument() override;
+
+public:
+  double getByteLength() override;
+
+  // Parse `bytes` into the tape. Safe to call off the JS thread; throws
+  // std::invalid_argument on malformed JSON.
+  void parse(const uint8_t *bytes, size_t length);
+
+  // Raw JSI materialize() -> any: the equivalent of JSON.parse on the source.
+  jsi::Value materializeRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                            const jsi::Value *args, size_t count);
+
+  // Raw JSI lazy() -> any: objects/arrays as HostObject views over the tape.
+  jsi::Value lazyRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                     const jsi::Value *args, size_t count);
+
+  size_t getExternalMemorySize() noexcept override;
+
+protected:
+  void loadHybridMethods() override;
+
+private:
+  size_t _byteLength;
+  // Shared with the lazy views, which may outlive the document.
+  std::shared_ptr<JSONTape> _tape;
+};
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -8,11 +8,15 @@
  */
 
  #include "HybridTextDecoder.hpp"
+ #include "JSIByteSpan.hpp"
+ #include "ParallelUTF8.hpp"
+ #include "SingleByteDecoder.hpp"
  #include "TextDecoderUtils.hpp"
 
  #include <NitroModules/HybridObject.hpp>
 
  #include <algorithm>
+ #include <cstring>
  #include <stdexcept>
  #include <vector>
 
@@ -21,14 +25,142 @@
  namespace margelo::nitro::nitrotextdecoder {
  using namespace margelo::nitro;
  
+ namespace {
+
+ TextDecoderEncoding resolveEncoding(const std::string &label) {
+   auto kind = parseEncodingLabel(label);
+   if (!kind.has_value()) {
+     throw std::invalid_argument("Unsupported encoding: " + label);
+   }
+   return kind.value();
+ }
+
+
+ // UTF-16 output scratch shared by the decode paths (one per JS thread).
+ char16_t *utf16Scratch(size_t units) {
+   static thread_local std::vector<char16_t> buf;
+   if (buf.size() < units) buf.resize(units);
+   return buf.data();
+ }
+
+ // Resolve an ArrayBuffer, TypedArray or DataView to its bytes, reading
+ // byteOffset/byteLength off the view directly. `caller` prefixes errors.
+ void resolveInput(jsi::Runtime &runtime, const jsi::Value &value,
+                   const char *caller, const uint8_t **bytes,
+                   size_t *length) {
+   ByteSpan span;
+   if (!tryGetByteSpan(runtime, value, &span)) [[unlikely]] {
+     throw jsi::JSError(runtime, std::string(caller) +
+                                     " input must be an ArrayBuffer or TypedArray");
+   }
+   *bytes = span.data;
+   *length = span.length;
+ }
+
+ // Parse the { stream } option object at args[index].
+ bool parseStreamOption(jsi::Runtime &runtime, const jsi::Value *args,
+                        size_t count, size_t index) {
+   if (count <= index || !args[index].isObject()) {
+     return false;
+   }
+   jsi::Value streamVal =
+       args[index].asObject(runtime).getProperty(
+           runtime, PropNameIDCache::get(runtime, "stream"));
+   return streamVal.isBool() && streamVal.getBool();
+ }
+
+ jsi::Array requireInputArray(jsi::Runtime &runtime, const jsi::Value *args,
+                              size_t count) {
+   if (count == 0 || !args[0].isObject() ||
+       !args[0].getObject(runtime).isArray(runtime)) [[unlikely]] {
+     throw jsi::JSError(runtime,
+                        "TextDecoder.decodeMany() inputs must be an array");
+   }
+   return args[0].getObject(runtime).getArray(runtime);
+ }
+
+ // Validate and transcode a UTF-8 body (BOM and any partial tail already
+ // removed) to a JS string, prefixed by `*head` when given. Throws
+ // std::invalid_argument on ill-formed input if `fatal`.
+ jsi::Value decodeUTF8Body(jsi::Runtime &runtime, const uint8_t *bytes,
+                           size_t length, bool fatal, const char32_t *head) {
+   // Very large inputs are validated, sized and transcoded across the
+   // worker pool instead (ParallelUTF8); ill-formed ones still take the
+   // single-threaded replacement path below.
+   ParallelUTF8Decode parallel;
+   bool useParallel = length >= parallelDecodeMinBytes();
+   size_t asciiLen;
+   bool valid;
+   if (useParallel) [[unlikely]] {
+     valid = parallel.validate(bytes, length);
+     asciiLen = valid && parallel.utf16Length() == length ? length : 0;
+   } else {
+     asciiLen = findASCIIPrefixLength(bytes, length);
+     valid = asciiLen == length;
+     if (!valid) {
+       auto validation = simdutf::validate_utf8_with_errors(
+           reinterpret_cast<const char *>(bytes + asciiLen),
+           length - asciiLen);
+       valid = asciiLen + validation.count == length;
+     }
+   }
+
+   if (!valid && fatal) [[unlikely]] {
+     throw std::invalid_argument("The encoded data was not valid UTF-8");
+   }
+
+   if (head == nullptr && valid) [[likely]] {
+     if (asciiLen == length) [[likely]] {
+       return jsi::String::createFromAscii(
+           runtime, reinterpret_cast<const char *>(bytes), length);
+     }
+     // Short chunks: Hermes' scalar transcode beats simdutf setup.
+     if (length < kSimdMinBytes) {
+       return jsi::String::createFromUtf8(runtime, bytes, length);
+     }
+   }
+
+   // Every input byte yields at most one UTF-16 unit (ill-formed runs
+   // collapse to one U+FFFD), plus up to two for the head code point.
+   char16_t *u16Buf = utf16Scratch(length + 2);
+   size_t written = 0;
+   if (head != nullptr) {
+     if (*head > 0xFFFF) {
+       u16Buf[0] = static_cast<char16_t>(0xD7C0 + (*head >> 10));
+       u16Buf[1] = static_cast<char16_t>(0xDC00 + (*head & 0x3FF));
+       written = 2;
+     } else {
+       u16Buf[0] = static_cast<char16_t>(*head);
+       written = 1;
+     }
+   }
+   if (valid && useParallel && parallel.convert(u16Buf + written))
+       [[unlikely]] {
+     written += parallel.utf16Length();
+   } else if (valid) [[likely]] {
+     written += simdutf::convert_valid_utf8_to_utf16le(
+         reinterpret_cast<const char *>(bytes), length, u16Buf + written);
+   } else {
+     // Non-fatal ill-formed input: single pass, simdutf for the valid runs
+     // and U+FFFD per maximal subpart — no repaired UTF-8 intermediate.
+     written +=
+         convertUTF8ToUTF16WithReplacement(bytes, length, u16Buf + written);
+   }
+   return jsi::String::createFromUtf16(runtime, u16Buf, written);
+ }
+
+ } // namespace
+
  // Constructor
  HybridTextDecoder::HybridTextDecoder(const std::string &encoding, bool fatal,
-                                      bool ignoreBOM)
-     : HybridObject(TAG), _encoding(normalizeEncoding(encoding)), _fatal(fatal),
-       _ignoreBOM(ignoreBOM), _bomSeen(false), _pendingCount(0) {
-   if (_encoding != "utf-8") {
-     throw std::invalid_argument("Unsupported encoding: " + encoding +
-                                 " (only UTF-8 is supported)");
+                                      bool ignoreBOM, size_t internMaxBytes,
+                                      size_t internEntries)
+     : HybridObject(TAG), _kind(resolveEncoding(encoding)),
+       _encoding(getEncodingName(_kind)), _fatal(fatal), _ignoreBOM(ignoreBOM),
+       _bomSeen(false), _pendingCount(0) {
+   if (internMaxBytes > 0 && internEntries > 0) {
+     _intern = std::make_unique<StringInternCache>(internMaxBytes,
+                                                   internEntries);
    }
  }
  
@@ -41,6 +173,19 @@
  bool HybridTextDecoder::getFatal() { return _fatal; }
  
  bool HybridTextDecoder::getIgnoreBOM() { return _ignoreBOM; }
+
+ InternStats HybridTextDecoder::getInternStats() {
+   if (!_intern) return InternStats(0, 0, 0, 0);
+   auto stats = _intern->stats();
+   return InternStats(static_cast<double>(stats.hits),
+                      static_cast<double>(stats.misses),
+                      static_cast<double>(stats.evictions),
+                      static_cast<double>(stats.entries));
+ }
+
+ void HybridTextDecoder::resetInternStats() {
+   if (_intern) _intern->resetStats();
+ }
  
  // Typed decode — retained for interface compliance but not actually
  // registered on the prototype. loadHybridMethods below binds "decode" to the
@@ -73,12 +218,44 @@
      inputBytes = buffer->data() + offset;
      inputLength = length;
    }
+   if (_kind != TextDecoderEncoding::UTF8) {
+     const char16_t *units = nullptr;
+     size_t n = isSingleByteEncoding(_kind)
+                    ? decodeLegacy(inputBytes, inputLength, &units)
+                    : decodeUTF16(inputBytes, inputLength, stream, &units);
+     std::string out(simdutf::utf8_length_from_utf16(units, n), '\0');
+     simdutf::convert_valid_utf16_to_utf8(units, n, out.data());
+     return out;
+   }
    return decodeImpl(inputBytes, inputLength, stream);
  }
 
- // Override loadHybridMethods to bind "decode" to a raw JSI entry point —
- // bypasses std::optional unpacking and shared_ptr<ArrayBuffer> allocation.
- // Skips the spec's auto-registration of the typed decode.
+ std::vector<std::string> HybridTextDecoder::decodeMany(
+     const std::vector<std::shared_ptr<ArrayBuffer>> &inputs,
+     const std::optional<TextDecodeOptions> &options) {
+   bool stream = options.has_value() && options->stream.value_or(false);
+   std::vector<std::string> result;
+   result.reserve(inputs.size());
+   for (size_t i = 0; i < inputs.size(); ++i) {
+     result.push_back(decode(inputs[i], std::nullopt, std::nullopt,
+                             TextDecodeOptions(stream || i + 1 < inputs.size())));
+   }
+   return result;
+ }
+
+ std::string HybridTextDecoder::decodeManyJoined(
+     const std::vector<std::shared_ptr<ArrayBuffer>> &inputs,
+     const std::optional<TextDecodeOptions> &options) {
+   std::string result;
+   for (const std::string &part : decodeMany(inputs, options)) {
+     result += part;
+   }
+   return result;
+ }
+
+ // Override loadHybridMethods to bind the decode methods to raw JSI entry
+ // points — bypasses std::optional unpacking and shared_ptr<ArrayBuffer>
+ // allocation. Skips the spec's auto-registration of the typed methods.
  void HybridTextDecoder::loadHybridMethods() {
    HybridObject::loadHybridMethods();
    registerHybrids(this, [](Prototype &proto) {
@@ -86,6 +263,14 @@
      proto.registerHybridGetter("fatal", &HybridTextDecoder::getFatal);
      proto.registerHybridGetter("ignoreBOM", &HybridTextDecoder::getIgnoreBOM);
      proto.registerRawHybridMethod("decode", 2, &HybridTextDecoder::decodeRaw);
+     proto.registerRawHybridMethod("decodeMany", 2,
+                                   &HybridTextDecoder::decodeManyRaw);
+     proto.registerRawHybridMethod("decodeManyJoined", 2,
+                                   &HybridTextDecoder::decodeManyJoinedRaw);
+     proto.registerHybridMethod("getInternStats",
+                                &HybridTextDecoder::getInternStats);
+     proto.registerHybridMethod("resetInternStats",
+                                &HybridTextDecoder::resetInternStats);
    });
  }
 
@@ -97,128 +282,345 @@
                                          const jsi::Value *args, size_t count) {
    const uint8_t *inputBytes = nullptr;
    size_t inputLength = 0;
-
    if (count > 0 && !args[0].isUndefined() && !args[0].isNull()) {
-     if (!args[0].isObject()) [[unlikely]] {
-       throw jsi::JSError(runtime,
-                          "TextDecoder.decode() input must be an ArrayBuffer or TypedArray");
+     resolveInput(runtime, args[0], "TextDecoder.decode()", &inputBytes,
+                  &inputLength);
+   }
+   bool stream = parseStreamOption(runtime, args, count, 1);
+
+   try {
+     return decodeChunk(runtime, inputBytes, inputLength, stream);
+   } catch (const std::exception &e) {
+     throw jsi::JSError(runtime, e.what());
+   }
+ }
+
+ // Stateless one-shot decode for NitroTextEncoding.decodeUTF8(input, fatal?):
+ // what `new TextDecoder('utf-8', { fatal }).decode(input)` returns, without
+ // creating (and later collecting) a decoder per call.
+ jsi::Value HybridTextDecoder::decodeUTF8Once(jsi::Runtime &runtime,
+                                              const jsi::Value &input,
+                                              bool fatal) {
+   const uint8_t *bytes = nullptr;
+   size_t length = 0;
+   if (!input.isUndefined() && !input.isNull()) {
+     resolveInput(runtime, input, "decodeUTF8()", &bytes, &length);
+   }
+   if (length >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB &&
+       bytes[2] == 0xBF) {
+     bytes += 3;
+     length -= 3;
+   }
+   try {
+     return decodeUTF8Body(runtime, bytes, length, fatal, nullptr);
+   } catch (const std::exception &e) {
+     throw jsi::JSError(runtime, e.what());
+   }
+ }
+
+ // Raw JSI decodeMany. Signature: decodeMany(inputs[], options?) -> string[].
+ // One crossing for a whole backlog: every element but the last is decoded
+ // with stream=true, so a sequence split between two buffers is carried over;
+ // the last one honours options.stream. An empty list decodes nothing.
+ jsi::Value HybridTextDecoder::decodeManyRaw(jsi::Runtime &runtime,
+                                             const jsi::Value & /*thisVal*/,
+                                             const jsi::Value *args,
+                                             size_t count) {
+   jsi::Array inputs = requireInputArray(runtime, args, count);
+   bool stream = parseStreamOption(runtime, args, count, 1);
+   size_t n = inputs.size(runtime);
+   jsi::Array result(runtime, n);
+   try {
+     for (size_t i = 0; i < n; ++i) {
+       const uint8_t *bytes = nullptr;
+       size_t length = 0;
+       resolveInput(runtime, inputs.getValueAtIndex(runtime, i),
+                    "TextDecoder.decodeMany()", &bytes, &length);
+       result.setValueAtIndex(
+           runtime, i, decodeChunk(runtime, bytes, length, stream || i + 1 < n));
+     }
+   } catch (const std::exception &e) {
+     throw jsi::JSError(runtime, e.what());
+   }
+   return result;
+ }
+
+ // Raw JSI decodeManyJoined. Signature: decodeManyJoined(inputs[], options?)
+ // -> string. Streaming across the elements is the same as decoding their
+ // concatenation, so the bytes are gathered into one scratch buffer and
+ // decoded in a single pass.
+ jsi::Value HybridTextDecoder::decodeManyJoinedRaw(
+     jsi::Runtime &runtime, const jsi::Value & /*thisVal*/,
+     const jsi::Value *args, size_t count) {
+   jsi::Array inputs = requireInputArray(runtime, args, count);
+   bool stream = parseStreamOption(runtime, args, count, 1);
+   size_t n = inputs.size(runtime);
+
+   // Reused across calls on this JS thread, up to kScratchRetainBytes.
+   static thread_local std::vector<uint8_t> joined;
+   ReleaseScratchIfLarge<std::vector<uint8_t>> release{joined};
+   joined.clear();
+   const uint8_t *bytes = nullptr;
+   size_t length = 0;
+   for (size_t i = 0; i < n; ++i) {
+     const uint8_t *chunk = nullptr;
+     size_t chunkLength = 0;
+     resolveInput(runtime, inputs.getValueAtIndex(runtime, i),
+                  "TextDecoder.decodeMany()", &chunk, &chunkLength);
+     if (n == 1) {
+       bytes = chunk; // single element: decode in place
+       length = chunkLength;
+     } else if (chunkLength > 0) {
+       joined.insert(joined.end(), chunk, chunk + chunkLength);
      }
-     jsi::Object obj = args[0].asObject(runtime);
+   }
+   if (n > 1) {
+     bytes = joined.data();
+     length = joined.size();
+   }
 
-     if (obj.isArrayBuffer(runtime)) {
-       // Direct ArrayBuffer.
-       jsi::ArrayBuffer ab = obj.getArrayBuffer(runtime);
-       inputBytes = ab.data(runtime);
-       inputLength = ab.size(runtime);
-     } else {
-       // TypedArray or DataView: read underlying buffer + view offsets.
-       jsi::Value bufferVal = obj.getProperty(runtime, "buffer");
-       if (!bufferVal.isObject()) [[unlikely]] {
-         throw jsi::JSError(runtime,
-                            "TextDecoder.decode() input must be an ArrayBuffer or TypedArray");
-       }
-       jsi::Object bufferObj = bufferVal.asObject(runtime);
-       if (!bufferObj.isArrayBuffer(runtime)) [[unlikely]] {
-         throw jsi::JSError(runtime,
-                            "TextDecoder.decode() input must be an ArrayBuffer or TypedArray");
-       }
-       jsi::ArrayBuffer ab = bufferObj.getArrayBuffer(runtime);
-       uint8_t *fullData = ab.data(runtime);
-       size_t fullSize = ab.size(runtime);
-
-       jsi::Value offsetVal = obj.getProperty(runtime, "byteOffset");
-       jsi::Value lengthVal = obj.getProperty(runtime, "byteLength");
-       size_t offset = offsetVal.isNumber()
-                           ? static_cast<size_t>(offsetVal.asNumber())
-                           : 0;
-       size_t length = lengthVal.isNumber()
-                           ? static_cast<size_t>(lengthVal.asNumber())
-                           : fullSize;
-       if (offset + length > fullSize) [[unlikely]] {
-         throw jsi::JSError(runtime,
-                            "byteOffset + byteLength exceeds buffer size");
-       }
-       inputBytes = fullData + offset;
-       inputLength = length;
+   try {
+     return decodeChunk(runtime, bytes, length, stream);
+   } catch (const std::exception &e) {
+     throw jsi::JSError(runtime, e.what());
+   }
+ }
+
+ // Decode one chunk of input to a JS string, updating the streaming state.
+ // With interning on, a short self-contained chunk (no carried-over bytes,
+ // no stream tail, BOM handling not yet decided) depends only on its bytes,
+ // so a cached string for the same bytes is returned as-is.
+ jsi::Value HybridTextDecoder::decodeChunk(jsi::Runtime &runtime,
+                                           const uint8_t *inputBytes,
+                                           size_t inputLength, bool stream) {
+   if (_intern && !stream && inputBytes != nullptr && inputLength > 0 &&
+       inputLength <= _intern->maxBytes() && _pendingCount == 0 &&
+       !_bomSeen) [[unlikely]] {
+     if (auto cached = _intern->find(runtime, inputBytes, inputLength)) {
+       return std::move(*cached);
      }
+     jsi::Value value =
+         transcodeChunk(runtime, inputBytes, inputLength, /*stream*/ false);
+     _intern->store(runtime, inputBytes, inputLength, value);
+     return value;
    }
+   return transcodeChunk(runtime, inputBytes, inputLength, stream);
+ }
 
-   // Parse { stream } option from args[1].
-   bool stream = false;
-   if (count > 1 && !args[1].isUndefined() && !args[1].isNull() &&
-       args[1].isObject()) {
-     jsi::Object options = args[1].asObject(runtime);
-     jsi::Value streamVal = options.getProperty(runtime, "stream");
-     if (streamVal.isBool()) {
-       stream = streamVal.getBool();
+ jsi::Value HybridTextDecoder::transcodeChunk(jsi::Runtime &runtime,
+                                              const uint8_t *inputBytes,
+                                              size_t inputLength, bool stream) {
+   if (isSingleByteEncoding(_kind)) {
+     size_t len = inputBytes ? inputLength : 0;
+     if (findASCIIPrefixLength(inputBytes, len) == len) [[likely]] {
+       return jsi::String::createFromAscii(
+           runtime, reinterpret_cast<const char *>(inputBytes), len);
      }
+     const char16_t *units = nullptr;
+     size_t n = decodeLegacy(inputBytes, len, &units);
+     return jsi::String::createFromUtf16(runtime, units, n);
+   }
+   if (_kind != TextDecoderEncoding::UTF8) {
+     const char16_t *units = nullptr;
+     size_t n = decodeUTF16(inputBytes, inputLength, stream, &units);
+     return jsi::String::createFromUtf16(runtime, units, n);
    }
 
+   const uint8_t *dataStart = inputBytes;
+   size_t dataLen = inputBytes ? inputLength : 0;
+
+   // A code point split by the previous chunk boundary: finish it from the
+   // first 1-3 bytes here, so the rest of the chunk can still take the
+   // SIMD path below instead of dropping into decodeImpl.
+   bool hadPending = _pendingCount > 0;
+   bool hasHead = false;
+   char32_t head = 0;
+   if (hadPending) [[unlikely]] {
+     size_t consumed = 0;
+     hasHead = finishPendingSequence(dataStart, dataLen, stream, &consumed,
+                                     &head);
+     dataStart += consumed;
+     dataLen -= consumed;
+     if (!hasHead) {
+       // Still mid-sequence (stream mode, chunk exhausted).
+       return jsi::String::createFromAscii(runtime, "", 0);
+     }
+     if (head == 0xFEFF && !_ignoreBOM && !_bomSeen) {
+       hasHead = false; // BOM split across chunks
+     }
+   }
+
+   bool bomStripped = false;
+   if (!hadPending && !_ignoreBOM && !_bomSeen && dataLen >= 3 &&
+       dataStart[0] == 0xEF && dataStart[1] == 0xBB &&
+       dataStart[2] == 0xBF) {
+     dataStart += 3;
+     dataLen -= 3;
+     bomStripped = true;
+   }
+
+   // In stream mode, hold back a trailing partial sequence for the next
+   // call rather than failing validation on it.
+   size_t tailLen = stream ? incompleteUTF8TailLength(dataStart, dataLen) : 0;
+   size_t bodyLen = dataLen - tailLen;
+
+   if (tailLen > 0) {
+     std::memcpy(_pendingBytes, dataStart + bodyLen, tailLen);
+   }
+   _pendingCount = tailLen;
+   _bomSeen = stream &&
+              (_bomSeen || hadPending || bomStripped || bodyLen > 0);
+
    try {
-     if (_pendingCount == 0 && inputBytes && inputLength > 0) [[likely]] {
-       const uint8_t *dataStart = inputBytes;
-       size_t dataLen = inputLength;
-       if (!_ignoreBOM && !_bomSeen && dataLen >= 3 &&
-           dataStart[0] == 0xEF && dataStart[1] == 0xBB &&
-           dataStart[2] == 0xBF) {
-         dataStart += 3;
-         dataLen -= 3;
-       }
+     return decodeUTF8Body(runtime, dataStart, bodyLen, _fatal,
+                           hasHead ? &head : nullptr);
+   } catch (const std::invalid_argument &) {
+     // Fatal error: the next call starts from a fresh state.
+     _pendingCount = 0;
+     _bomSeen = false;
+     throw;
+   }
+ }
 
-       size_t asciiLen = findASCIIPrefixLength(dataStart, dataLen);
-       if (asciiLen == dataLen) [[likely]] {
-         _bomSeen = stream;
-         return jsi::String::createFromAscii(
-             runtime,
-             reinterpret_cast<const char *>(dataStart),
-             dataLen);
-       }
+ // Complete the sequence buffered in _pendingBytes from the first 1-3 bytes
+ // of `bytes`. Returns true and sets *codePoint (U+FFFD if ill-formed) once the
+ // sequence is resolved; returns false if it is still incomplete in stream
+ // mode (the consumed bytes are appended to _pendingBytes). *consumed is the
+ // number of input bytes that belong to the resolved sequence.
+ bool HybridTextDecoder::finishPendingSequence(const uint8_t *bytes,
+                                               size_t length, bool stream,
+                                               size_t *consumed,
+                                               char32_t *codePoint) {
+   uint8_t seq[4];
+   size_t pendingCount = _pendingCount;
+   std::memcpy(seq, _pendingBytes, pendingCount);
+   size_t need = validUTF8SequenceLength(seq[0]) - pendingCount;
+   size_t take = std::min(need, length);
+   if (take > 0) {
+     std::memcpy(seq + pendingCount, bytes, take);
+   }
+   size_t seqLen = pendingCount + take;
+   _pendingCount = 0;
 
-       auto validation = simdutf::validate_utf8_with_errors(
-           reinterpret_cast<const char *>(dataStart + asciiLen),
-           dataLen - asciiLen);
-       size_t validLen = asciiLen + validation.count;
-       if (validLen == dataLen) [[likely]] {
-         _bomSeen = stream;
-         // Below this size simdutf setup costs more than Hermes' scalar
-         // transcode amortizes — hand raw bytes to Hermes instead.
-         constexpr size_t kSimdMinBytes = 256;
-         if (dataLen >= kSimdMinBytes) {
-           static thread_local std::vector<char16_t> u16Buf;
-           if (u16Buf.size() < dataLen) u16Buf.resize(dataLen);
-           size_t written = simdutf::convert_valid_utf8_to_utf16le(
-               reinterpret_cast<const char *>(dataStart), dataLen,
-               u16Buf.data());
-           return jsi::String::createFromUtf16(
-               runtime, u16Buf.data(), written);
-         }
-         return jsi::String::createFromUtf8(runtime, dataStart, dataLen);
-       }
+   if (take < need && isValidPartialUTF8(seq, seqLen)) {
+     *consumed = take;
+     if (stream) {
+       std::memcpy(_pendingBytes, seq, seqLen);
+       _pendingCount = seqLen;
+       return false;
      }
+     // End of input inside a sequence.
+     if (_fatal) {
+       throw std::invalid_argument("The encoded data was not valid UTF-8");
+     }
+     *codePoint = UNICODE_REPLACEMENT_CHARACTER;
+     return true;
+   }
 
-     std::string result = decodeImpl(inputBytes, inputLength, stream);
-     return jsi::String::createFromUtf8(
-         runtime,
-         reinterpret_cast<const uint8_t *>(result.data()),
-         result.size());
-   } catch (const std::exception &e) {
-     throw jsi::JSError(runtime, e.what());
+   if (take == need && findValidUTF8RunLength(seq, seqLen) == seqLen) {
+     *consumed = take;
+     *codePoint = decodeUTF8CodePoint(seq, seqLen);
+     return true;
+   }
+
+   // Ill-formed: one U+FFFD for the maximal subpart, then resume right after
+   // it (the offending byte is re-read as part of the body).
+   if (_fatal) {
+     throw std::invalid_argument("The encoded data was not valid UTF-8");
    }
+   size_t subpart = maximalSubpartLength(seq, seqLen);
+   *consumed = subpart > pendingCount ? subpart - pendingCount : 0;
+   *codePoint = UNICODE_REPLACEMENT_CHARACTER;
+   return true;
  }
  
- // Helper: normalize encoding name
- std::string HybridTextDecoder::normalizeEncoding(const std::string &encoding) {
-   std::string normalized = encoding;
-   std::transform(normalized.begin(), normalized.end(), normalized.begin(),
-                  ::tolower);
- 
-   if (normalized == "utf8" || normalized == "unicode-1-1-utf-8") {
-     return "utf-8";
+ // UTF-16LE/BE decode. Pending bytes and input are copied straight into the
+ // UTF-16 scratch buffer (the bytes already are code units), byte-swapped in
+ // place for BE, and surrogate pairing is checked with simdutf; lone
+ // surrogates are patched to U+FFFD in place. In stream mode an odd trailing
+ // byte and a trailing high surrogate are carried into the next call.
+ size_t HybridTextDecoder::decodeUTF16(const uint8_t *inputBytes,
+                                       size_t inputLength, bool stream,
+                                       const char16_t **units) {
+   bool bigEndian = _kind == TextDecoderEncoding::UTF16BE;
+   size_t total = _pendingCount + (inputBytes ? inputLength : 0);
+   char16_t *buf = utf16Scratch(total / 2 + 1);
+   uint8_t *raw = reinterpret_cast<uint8_t *>(buf);
+   if (_pendingCount > 0) {
+     std::memcpy(raw, _pendingBytes, _pendingCount);
    }
- 
-   return normalized;
+   if (inputBytes && inputLength > 0) {
+     std::memcpy(raw + _pendingCount, inputBytes, inputLength);
+   }
+   _pendingCount = 0;
+
+   size_t unitCount = total / 2;
+   bool oddByte = (total & 1) != 0;
+   uint8_t lastByte = oddByte ? raw[total - 1] : 0;
+   if (bigEndian) {
+     simdutf::change_endianness_utf16(buf, unitCount, buf);
+   }
+
+   size_t start = 0;
+   if (!_ignoreBOM && !_bomSeen && unitCount > 0 && buf[0] == 0xFEFF) {
+     start = 1;
+   }
+   size_t end = unitCount;
+   if (stream) {
+     if (end > start && isHighSurrogate(buf[end - 1])) {
+       char16_t held = buf[--end];
+       _pendingBytes[0] = static_cast<uint8_t>(bigEndian ? held >> 8 : held);
+       _pendingBytes[1] = static_cast<uint8_t>(bigEndian ? held : held >> 8);
+       _pendingCount = 2;
+     }
+     if (oddByte) {
+       _pendingBytes[_pendingCount++] = lastByte;
+     }
+   } else if (oddByte && end > start && isHighSurrogate(buf[end - 1])) {
+     --end; // surrogate + odd byte at end of input: a single error below
+   }
+
+   for (size_t pos = start; pos < end;) {
+     auto result = simdutf::validate_utf16_with_errors(buf + pos, end - pos);
+     if (result.error == simdutf::error_code::SUCCESS) {
+       break;
+     }
+     if (_fatal) [[unlikely]] {
+       _pendingCount = 0;
+       _bomSeen = false;
+       throw std::invalid_argument("Invalid UTF-16: lone surrogate");
+     }
+     buf[pos + result.count] = UNICODE_REPLACEMENT_CHARACTER;
+     pos += result.count + 1;
+   }
+
+   if (!stream && oddByte) {
+     if (_fatal) [[unlikely]] {
+       _bomSeen = false;
+       throw std::invalid_argument("Invalid UTF-16 data (odd byte count)");
+     }
+     buf[end++] = UNICODE_REPLACEMENT_CHARACTER;
+   }
+
+   _bomSeen = stream && (_bomSeen || unitCount > 0);
+   *units = buf + start;
+   return end - start;
  }
- 
+
+ size_t HybridTextDecoder::decodeLegacy(const uint8_t *inputBytes,
+                                        size_t inputLength,
+                                        const char16_t **units) {
+   size_t length = inputBytes ? inputLength : 0;
+   char16_t *buf = utf16Scratch(length);
+   if (!decodeSingleByte(_kind, inputBytes, length, buf) && _fatal)
+       [[unlikely]] {
+     throw std::invalid_argument("The encoded data was not valid " +
+                                 _encoding);
+   }
+   *units = buf;
+   return length;
+ }
+
  // Core decode implementation.
  std::string HybridTextDecoder::decodeImpl(const uint8_t *inputBytes,
                                            size_t inputLength, bool stream) {
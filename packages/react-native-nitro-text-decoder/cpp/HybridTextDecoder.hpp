@@ -9,9 +9,12 @@
  #pragma once
 
  #include "HybridNitroTextDecoderSpec.hpp"
+ #include "StringInternCache.hpp"
+ #include "TextDecoderUtils.hpp"
 
  #include <cstdint>
  #include <jsi/jsi.h>
+ #include <memory>
  #include <string>
  #include <vector>
 
@@ -21,13 +24,17 @@
  
  /**
   * C++ implementation of the `NitroTextDecoder` interface.
-  * Implements the WHATWG Encoding Standard UTF-8 decoder algorithm.
+  * Implements the WHATWG Encoding Standard UTF-8 and UTF-16LE/BE decoders and
+  * the single-byte legacy encodings.
   */
  class HybridTextDecoder : public HybridNitroTextDecoderSpec {
  public:
-   // Constructor with encoding, fatal flag, and ignoreBOM flag
+   // Constructor with encoding, fatal flag, and ignoreBOM flag. Interning
+   // is on when both intern arguments are non-zero (see decodeChunk).
    explicit HybridTextDecoder(const std::string &encoding = "utf-8",
-                              bool fatal = false, bool ignoreBOM = false);
+                              bool fatal = false, bool ignoreBOM = false,
+                              size_t internMaxBytes = 0,
+                              size_t internEntries = 0);
  
    // Destructor
    ~HybridTextDecoder() override;
@@ -52,28 +59,76 @@
    jsi::Value decodeRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
                         const jsi::Value *args, size_t count);
 
+   std::vector<std::string>
+   decodeMany(const std::vector<std::shared_ptr<ArrayBuffer>> &inputs,
+              const std::optional<TextDecodeOptions> &options) override;
+   std::string
+   decodeManyJoined(const std::vector<std::shared_ptr<ArrayBuffer>> &inputs,
+                    const std::optional<TextDecodeOptions> &options) override;
+
+   // Raw JSI decodeMany(inputs[], options?): decodes a batch of buffers/views
+   // in one crossing, carrying streaming state from element to element.
+   jsi::Value decodeManyRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                            const jsi::Value *args, size_t count);
+
+   // Raw JSI decodeManyJoined(inputs[], options?): as decodeMany, but returns
+   // the concatenation as a single string.
+   jsi::Value decodeManyJoinedRaw(jsi::Runtime &runtime,
+                                  const jsi::Value &thisVal,
+                                  const jsi::Value *args, size_t count);
+
+   InternStats getInternStats() override;
+   void resetInternStats() override;
+
+   // One-shot UTF-8 decode with no decoder instance or streaming state
+   // (BOM stripped). Backs NitroTextEncoding.decodeUTF8.
+   static jsi::Value decodeUTF8Once(jsi::Runtime &runtime,
+                                    const jsi::Value &input, bool fatal);
+
  protected:
-   // Override to register "decode" as a raw method instead of Nitro's auto
-   // typed registration.
+   // Override to register the decode methods as raw methods instead of
+   // Nitro's auto typed registration.
    void loadHybridMethods() override;
 
  private:
-   // Core decode implementation used by both typed and raw methods
+   // Decode one chunk to a JS string; shared by the raw entry points.
+   jsi::Value decodeChunk(jsi::Runtime &runtime, const uint8_t *inputBytes,
+                          size_t inputLength, bool stream);
+
+   // decodeChunk without the intern cache.
+   jsi::Value transcodeChunk(jsi::Runtime &runtime, const uint8_t *inputBytes,
+                             size_t inputLength, bool stream);
+
+   // Core UTF-8 decode implementation used by the typed methods
    std::string decodeImpl(const uint8_t *inputBytes, size_t inputLength,
                           bool stream);
+
+   // Resolve a sequence split across the previous chunk boundary.
+   bool finishPendingSequence(const uint8_t *bytes, size_t length, bool stream,
+                              size_t *consumed, char32_t *codePoint);
  
-   // Helper methods
-   std::string normalizeEncoding(const std::string &encoding);
+   // UTF-16LE/BE decode into thread-local scratch; returns the unit count
+   // and points *units at the first one.
+   size_t decodeUTF16(const uint8_t *inputBytes, size_t inputLength,
+                      bool stream, const char16_t **units);
+
+   // Single-byte (windows-125x, ISO-8859-x, ...) decode; stateless.
+   size_t decodeLegacy(const uint8_t *inputBytes, size_t inputLength,
+                       const char16_t **units);
  
  private:
+   TextDecoderEncoding _kind;
    std::string _encoding;
    bool _fatal;
    bool _ignoreBOM;
  
    // Streaming state (matching Hermes implementation)
    bool _bomSeen;
-   uint8_t _pendingBytes[4];
+   uint8_t _pendingBytes[4]; // UTF-16: odd byte and/or a held high surrogate
    size_t _pendingCount;
+
+   // Opt-in cache of short decoded strings; null when interning is off.
+   std::unique_ptr<StringInternCache> _intern;
  };
  
  } // namespace margelo::nitro::nitrotextdecoder
\ No newline at end of file
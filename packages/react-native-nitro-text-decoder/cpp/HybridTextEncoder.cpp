@@ -0,0 +1,418 @@
+/*
+ * TextEncoder implementation for Nitro.
+ *
+ * UTF-16 -> UTF-8 transcoding is delegated to simdutf; lone surrogates are
+ * replaced with U+FFFD as required by the WHATWG Encoding Standard.
+ */
+
+#include "HybridTextEncoder.hpp"
+#include "JSIByteSpan.hpp"
+#include "TextDecoderUtils.hpp"
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/HybridObject.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "simdutf.h"
+
+namespace margelo::nitro::nitrotextdecoder {
+using namespace margelo::nitro;
+
+namespace {
+
+// Walk a jsi::String's backing storage in place. `onAscii(const char*, n)` is
+// called for 8-bit segments, `onUTF16(const char16_t*, n)` for 16-bit ones.
+// A high surrogate at the end of a segment is held back and re-joined with a
+// low surrogate at the start of the next, so the callbacks never see a split
+// pair (Hermes hands over a single segment; ropes may be chunked).
+template <typename OnAscii, typename OnUTF16>
+void visitStringData(jsi::Runtime &runtime, const jsi::String &str,
+                     OnAscii &&onAscii, OnUTF16 &&onUTF16) {
+  char16_t carry = 0;
+  bool hasCarry = false;
+  auto cb = [&](bool ascii, const void *data, size_t num) {
+    if (ascii) {
+      if (hasCarry) {
+        hasCarry = false;
+        onUTF16(&carry, 1);
+      }
+      onAscii(static_cast<const char *>(data), num);
+      return;
+    }
+    const char16_t *units = static_cast<const char16_t *>(data);
+    if (hasCarry) {
+      hasCarry = false;
+      if (num > 0 && isLowSurrogate(units[0])) {
+        const char16_t pair[2] = {carry, units[0]};
+        onUTF16(pair, 2);
+        ++units;
+        --num;
+      } else {
+        onUTF16(&carry, 1);
+      }
+    }
+    if (num > 0 && isHighSurrogate(units[num - 1])) {
+      carry = units[num - 1];
+      hasCarry = true;
+      --num;
+    }
+    if (num > 0) {
+      onUTF16(units, num);
+    }
+  };
+  str.getStringData(runtime, cb);
+  if (hasCarry) {
+    onUTF16(&carry, 1);
+  }
+}
+
+size_t utf8LengthOf(jsi::Runtime &runtime, const jsi::String &str) {
+  size_t total = 0;
+  visitStringData(
+      runtime, str, [&](const char *, size_t n) { total += n; },
+      [&](const char16_t *units, size_t n) {
+        total += simdutf::utf8_length_from_utf16_with_replacement(units, n)
+                     .count;
+      });
+  return total;
+}
+
+// UTF-8 width of the code point starting at units[0]; lone surrogates are
+// encoded as U+FFFD (3 bytes). `*consumed` receives the UTF-16 unit count.
+inline size_t scalarUTF8Width(const char16_t *units, size_t n,
+                              size_t *consumed) {
+  char16_t u = units[0];
+  *consumed = 1;
+  if (u < 0x80) return 1;
+  if (u < 0x800) return 2;
+  if (isHighSurrogate(u) && n > 1 && isLowSurrogate(units[1])) {
+    *consumed = 2;
+    return 4;
+  }
+  return 3;
+}
+
+// encodeInto for one UTF-16 segment: converts as much as fits in
+// [out, out + capacity) without splitting a code point. Every UTF-16 unit
+// expands to at most 3 UTF-8 bytes (a surrogate pair: 2 units -> 4 bytes), so
+// `room / 3` units always fit and go through simdutf in bulk; only the last
+// couple of bytes are placed one code point at a time.
+size_t encodeUTF16Into(const char16_t *units, size_t n, uint8_t *out,
+                       size_t capacity, size_t *written, bool *full) {
+  size_t read = 0;
+  while (read < n) {
+    size_t room = capacity - *written;
+    size_t take = std::min(n - read, room / 3);
+    if (take > 0 && read + take < n &&
+        isHighSurrogate(units[read + take - 1])) {
+      --take; // don't split a surrogate pair across bulk calls
+    }
+    if (take == 0) {
+      size_t consumed = 0;
+      size_t width = scalarUTF8Width(units + read, n - read, &consumed);
+      if (width > room) {
+        *full = true;
+        break;
+      }
+      *written += simdutf::convert_utf16_to_utf8_with_replacement(
+          units + read, consumed,
+          reinterpret_cast<char *>(out + *written));
+      read += consumed;
+      continue;
+    }
+    *written += simdutf::convert_utf16_to_utf8_with_replacement(
+        units + read, take, reinterpret_cast<char *>(out + *written));
+    read += take;
+  }
+  return read;
+}
+
+// Byte span of an ArrayBuffer or ArrayBufferView argument (byteOffset and
+// byteLength honoured). Throws `error` for anything else.
+void resolveBytes(jsi::Runtime &runtime, const jsi::Value &value,
+                  const char *error, uint8_t **data, size_t *length) {
+  ByteSpan span;
+  if (!tryGetByteSpan(runtime, value, &span)) [[unlikely]] {
+    throw jsi::JSError(runtime, error);
+  }
+  *data = span.data;
+  *length = span.length;
+}
+
+inline simdutf::base64_options base64Options(bool urlSafe) {
+  return urlSafe ? simdutf::base64_url : simdutf::base64_default;
+}
+
+// Decode base64 text into an exactly-sized ArrayBuffer. Whitespace is
+// skipped and the final padding is optional, as with atob().
+std::shared_ptr<ArrayBuffer> decodeBase64(const char *input, size_t length,
+                                          bool urlSafe) {
+  size_t maxLength = simdutf::maximal_binary_length_from_base64(input, length);
+  auto buffer = ArrayBuffer::allocate(maxLength);
+  simdutf::result result = simdutf::base64_to_binary(
+      input, length, reinterpret_cast<char *>(buffer->data()),
+      base64Options(urlSafe));
+  if (result.error != simdutf::error_code::SUCCESS) [[unlikely]] {
+    throw std::invalid_argument("Invalid base64 data at position " +
+                                std::to_string(result.count));
+  }
+  // maxLength is exact unless the input carried whitespace.
+  if (result.count != maxLength) [[unlikely]] {
+    return ArrayBuffer::copy(buffer->data(), result.count);
+  }
+  return buffer;
+}
+
+} // namespace
+
+HybridTextEncoder::HybridTextEncoder() : HybridObject(TAG) {}
+
+HybridTextEncoder::~HybridTextEncoder() = default;
+
+std::string HybridTextEncoder::getEncoding() { return "utf-8"; }
+
+// Typed variants — retained for interface compliance but not registered on
+// the prototype. Nitro has already converted `std::string` to UTF-8 here.
+std::shared_ptr<ArrayBuffer>
+HybridTextEncoder::encode(const std::optional<std::string> &input) {
+  if (!input.has_value() || input->empty()) {
+    return ArrayBuffer::allocate(0);
+  }
+  return ArrayBuffer::copy(reinterpret_cast<const uint8_t *>(input->data()),
+                           input->size());
+}
+
+TextEncoderEncodeIntoResult
+HybridTextEncoder::encodeInto(const std::string &source,
+                              const std::shared_ptr<ArrayBuffer> &destination,
+                              std::optional<double> byteOffset,
+                              std::optional<double> byteLength) {
+  if (!destination) [[unlikely]] {
+    throw std::invalid_argument("encodeInto() destination must be an ArrayBuffer");
+  }
+  size_t bufferSize = destination->size();
+  size_t offset =
+      byteOffset.has_value() ? static_cast<size_t>(byteOffset.value()) : 0;
+  size_t length = byteLength.has_value()
+                      ? static_cast<size_t>(byteLength.value())
+                      : (bufferSize - offset);
+  if (offset + length > bufferSize) [[unlikely]] {
+    throw std::invalid_argument("byteOffset + byteLength exceeds buffer size");
+  }
+  size_t copyLen = source.size();
+  if (copyLen > length) {
+    // Back off to a code point boundary.
+    copyLen = length;
+    while (copyLen > 0 &&
+           (static_cast<uint8_t>(source[copyLen]) & 0xC0) == 0x80) {
+      --copyLen;
+    }
+  }
+  std::memcpy(destination->data() + offset, source.data(), copyLen);
+  size_t read = simdutf::utf16_length_from_utf8(source.data(), copyLen);
+  return TextEncoderEncodeIntoResult(static_cast<double>(read),
+                                     static_cast<double>(copyLen));
+}
+
+double HybridTextEncoder::utf8Length(const std::string &input) {
+  return static_cast<double>(input.size());
+}
+
+std::string
+HybridTextEncoder::base64Encode(const std::shared_ptr<ArrayBuffer> &input,
+                                std::optional<double> byteOffset,
+                                std::optional<double> byteLength,
+                                std::optional<bool> urlSafe) {
+  size_t bufferSize = input ? input->size() : 0;
+  size_t offset =
+      byteOffset.has_value() ? static_cast<size_t>(byteOffset.value()) : 0;
+  size_t length = byteLength.has_value()
+                      ? static_cast<size_t>(byteLength.value())
+                      : (bufferSize - offset);
+  if (offset > bufferSize || offset + length > bufferSize) [[unlikely]] {
+    throw std::invalid_argument("byteOffset + byteLength exceeds buffer size");
+  }
+  if (length == 0) return {};
+  auto options = base64Options(urlSafe.value_or(false));
+  std::string out(simdutf::base64_length_from_binary(length, options), '\0');
+  simdutf::binary_to_base64(
+      reinterpret_cast<const char *>(input->data() + offset), length,
+      out.data(), options);
+  return out;
+}
+
+std::shared_ptr<ArrayBuffer>
+HybridTextEncoder::base64Decode(const std::string &input,
+                                std::optional<bool> urlSafe) {
+  return decodeBase64(input.data(), input.size(), urlSafe.value_or(false));
+}
+
+// Bind encode/encodeInto/utf8Length to raw JSI entry points — reads the JS
+// string in place instead of round-tripping through std::string.
+void HybridTextEncoder::loadHybridMethods() {
+  HybridObject::loadHybridMethods();
+  registerHybrids(this, [](Prototype &proto) {
+    proto.registerHybridGetter("encoding", &HybridTextEncoder::getEncoding);
+    proto.registerRawHybridMethod("encode", 1, &HybridTextEncoder::encodeRaw);
+    proto.registerRawHybridMethod("encodeInto", 2,
+                                  &HybridTextEncoder::encodeIntoRaw);
+    proto.registerRawHybridMethod("utf8Length", 1,
+                                  &HybridTextEncoder::utf8LengthRaw);
+    proto.registerRawHybridMethod("base64Encode", 1,
+                                  &HybridTextEncoder::base64EncodeRaw);
+    proto.registerRawHybridMethod("base64Decode", 1,
+                                  &HybridTextEncoder::base64DecodeRaw);
+  });
+}
+
+// Raw JSI encode. Signature: encode(input?) -> ArrayBuffer.
+// Two SIMD passes over the string (length, then transcode) let us allocate
+// the result exactly once, with no scratch buffer or trailing copy.
+jsi::Value HybridTextEncoder::encodeRaw(jsi::Runtime &runtime,
+                                        const jsi::Value & /*thisVal*/,
+                                        const jsi::Value *args,
+                                        size_t count) {
+  if (count == 0 || args[0].isUndefined()) {
+    return jsi::ArrayBuffer(runtime, ArrayBuffer::allocate(0));
+  }
+  jsi::String str = args[0].isString() ? args[0].getString(runtime)
+                                       : args[0].toString(runtime);
+
+  size_t length = utf8LengthOf(runtime, str);
+  auto buffer = ArrayBuffer::allocate(length);
+  uint8_t *out = buffer->data();
+  visitStringData(
+      runtime, str,
+      [&](const char *chars, size_t n) {
+        std::memcpy(out, chars, n);
+        out += n;
+      },
+      [&](const char16_t *units, size_t n) {
+        out += simdutf::convert_utf16_to_utf8_with_replacement(
+            units, n, reinterpret_cast<char *>(out));
+      });
+  return jsi::ArrayBuffer(runtime, buffer);
+}
+
+// Raw JSI encodeInto. Signature: encodeInto(source, destination) ->
+// { read, written }. `read` counts UTF-16 code units, per the WHATWG spec.
+jsi::Value HybridTextEncoder::encodeIntoRaw(jsi::Runtime &runtime,
+                                            const jsi::Value & /*thisVal*/,
+                                            const jsi::Value *args,
+                                            size_t count) {
+  if (count < 2 || !args[1].isObject()) [[unlikely]] {
+    throw jsi::JSError(runtime,
+                       "TextEncoder.encodeInto() destination must be a Uint8Array");
+  }
+  jsi::String str = args[0].isString() ? args[0].getString(runtime)
+                                       : args[0].toString(runtime);
+
+  uint8_t *dest = nullptr;
+  size_t capacity = 0;
+  resolveBytes(runtime, args[1],
+               "TextEncoder.encodeInto() destination must be a Uint8Array",
+               &dest, &capacity);
+
+  size_t read = 0;
+  size_t written = 0;
+  bool full = false;
+  visitStringData(
+      runtime, str,
+      [&](const char *chars, size_t n) {
+        if (full) return;
+        size_t take = std::min(n, capacity - written);
+        std::memcpy(dest + written, chars, take);
+        written += take;
+        read += take;
+        full = take < n;
+      },
+      [&](const char16_t *units, size_t n) {
+        if (full) return;
+        read += encodeUTF16Into(units, n, dest, capacity, &written, &full);
+      });
+
+  jsi::Object result(runtime);
+  result.setProperty(runtime, "read", static_cast<double>(read));
+  result.setProperty(runtime, "written", static_cast<double>(written));
+  return result;
+}
+
+// Raw JSI utf8Length. Signature: utf8Length(input) -> number.
+jsi::Value HybridTextEncoder::utf8LengthRaw(jsi::Runtime &runtime,
+                                            const jsi::Value & /*thisVal*/,
+                                            const jsi::Value *args,
+                                            size_t count) {
+  if (count == 0 || args[0].isUndefined()) {
+    return jsi::Value(0);
+  }
+  jsi::String str = args[0].isString() ? args[0].getString(runtime)
+                                       : args[0].toString(runtime);
+  return jsi::Value(static_cast<double>(utf8LengthOf(runtime, str)));
+}
+
+// Raw JSI base64Encode. Signature: base64Encode(bytes, urlSafe?) -> string.
+// Encodes straight from the JS-owned bytes into a per-thread scratch buffer
+// (kept up to kScratchRetainBytes) that backs the resulting (ASCII) string.
+jsi::Value HybridTextEncoder::base64EncodeRaw(jsi::Runtime &runtime,
+                                              const jsi::Value & /*thisVal*/,
+                                              const jsi::Value *args,
+                                              size_t count) {
+  constexpr auto kInputError =
+      "base64Encode() input must be an ArrayBuffer or ArrayBufferView";
+  if (count == 0) [[unlikely]] {
+    throw jsi::JSError(runtime, kInputError);
+  }
+  uint8_t *data = nullptr;
+  size_t length = 0;
+  resolveBytes(runtime, args[0], kInputError, &data, &length);
+  bool urlSafe = count > 1 && args[1].isBool() && args[1].getBool();
+  auto options = base64Options(urlSafe);
+  thread_local std::vector<char> scratch;
+  ReleaseScratchIfLarge<std::vector<char>> release{scratch};
+  size_t outLength = simdutf::base64_length_from_binary(length, options);
+  if (scratch.size() < outLength) {
+    scratch.resize(outLength);
+  }
+  simdutf::binary_to_base64(reinterpret_cast<const char *>(data), length,
+                            scratch.data(), options);
+  return jsi::String::createFromAscii(runtime, scratch.data(), outLength);
+}
+
+// Raw JSI base64Decode. Signature: base64Decode(input, urlSafe?) ->
+// ArrayBuffer. Throws on characters outside the alphabet.
+jsi::Value HybridTextEncoder::base64DecodeRaw(jsi::Runtime &runtime,
+                                              const jsi::Value & /*thisVal*/,
+                                              const jsi::Value *args,
+                                              size_t count) {
+  if (count == 0 || !args[0].isString()) [[unlikely]] {
+    throw jsi::JSError(runtime, "base64Decode() input must be a string");
+  }
+  bool urlSafe = count > 1 && args[1].isBool() && args[1].getBool();
+  // Base64 is ASCII; non-ASCII UTF-16 units become a byte simdutf rejects.
+  // The per-thread buffer is kept up to kScratchRetainBytes.
+  thread_local std::string text;
+  ReleaseScratchIfLarge<std::string> release{text};
+  text.clear();
+  visitStringData(
+      runtime, args[0].getString(runtime),
+      [&](const char *chars, size_t n) { text.append(chars, n); },
+      [&](const char16_t *units, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+          char16_t u = units[i];
+          text.push_back(u < 0x80 ? static_cast<char>(u) : '\x80');
+        }
+      });
+  try {
+    return jsi::ArrayBuffer(runtime,
+                            decodeBase64(text.data(), text.size(), urlSafe));
+  } catch (const std::invalid_argument &e) {
+    throw jsi::JSError(runtime, e.what());
+  }
+}
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -0,0 +1,80 @@
+/*
+ * TextEncoder implementation for Nitro.
+ *
+ * UTF-16 -> UTF-8 transcoding is delegated to simdutf; lone surrogates are
+ * replaced with U+FFFD as required by the WHATWG Encoding Standard.
+ */
+
+#pragma once
+
+#include "HybridNitroTextEncoderSpec.hpp"
+
+#include <cstdint>
+#include <jsi/jsi.h>
+#include <string>
+
+namespace margelo::nitro::nitrotextdecoder {
+
+namespace jsi = facebook::jsi;
+
+/**
+ * C++ implementation of the `NitroTextEncoder` interface.
+ * Implements the WHATWG Encoding Standard UTF-8 encoder (stateless).
+ */
+class HybridTextEncoder : public HybridNitroTextEncoderSpec {
+public:
+  HybridTextEncoder();
+  ~HybridTextEncoder() override;
+
+public:
+  // Properties (matching web spec TextEncoder interface)
+  std::string getEncoding() override;
+
+public:
+  // Methods - typed versions (required by base class signature, unused at
+  // runtime: we override loadHybridMethods to register raw-JSI variants).
+  std::shared_ptr<ArrayBuffer>
+  encode(const std::optional<std::string> &input) override;
+  TextEncoderEncodeIntoResult
+  encodeInto(const std::string &source,
+             const std::shared_ptr<ArrayBuffer> &destination,
+             std::optional<double> byteOffset,
+             std::optional<double> byteLength) override;
+  double utf8Length(const std::string &input) override;
+  std::string base64Encode(const std::shared_ptr<ArrayBuffer> &input,
+                           std::optional<double> byteOffset,
+                           std::optional<double> byteLength,
+                           std::optional<bool> urlSafe) override;
+  std::shared_ptr<ArrayBuffer>
+  base64Decode(const std::string &input, std::optional<bool> urlSafe) override;
+
+  // Raw JSI encode(input?): reads the string's UTF-16/ASCII storage in place
+  // via getStringData and transcodes straight into the result ArrayBuffer —
+  // no intermediate std::string as with Nitro's JSIConverter<std::string>.
+  jsi::Value encodeRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                       const jsi::Value *args, size_t count);
+
+  // Raw JSI encodeInto(source, destination): destination may be an
+  // ArrayBuffer or a TypedArray/DataView (byteOffset/byteLength honoured).
+  jsi::Value encodeIntoRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                           const jsi::Value *args, size_t count);
+
+  // Raw JSI utf8Length(input): UTF-8 byte length without encoding.
+  jsi::Value utf8LengthRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                           const jsi::Value *args, size_t count);
+
+  // Raw JSI base64Encode(bytes, urlSafe?) / base64Decode(string, urlSafe?):
+  // simdutf's vectorized base64 over an ArrayBuffer or view, reading the JS
+  // memory in place. urlSafe selects the unpadded base64url alphabet.
+  jsi::Value base64EncodeRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                             const jsi::Value *args, size_t count);
+  jsi::Value base64DecodeRaw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                             const jsi::Value *args, size_t count);
+
+protected:
+  // Override to register encode/encodeInto/utf8Length/base64* as raw methods
+  // instead of Nitro's auto typed registration.
+  void loadHybridMethods() override;
+};
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -1,5 +1,8 @@
 #include "HybridTextEncoding.hpp"
+#include "HybridJSONDocument.hpp"
 #include "HybridTextDecoder.hpp"
+#include "HybridTextEncoder.hpp"
+#include "ParallelUTF8.hpp"
 #include <algorithm>
 #include <stdexcept>
 
@@ -24,29 +27,115 @@ std::shared_ptr<HybridNitroTextDecoderSpec> HybridTextEncoding::createDecoder(
                        ? options->ignoreBOM.value()
                        : false;
 
-  // Validate that only UTF-8 is requested
-  std::string normalized = normalizeEncoding(encoding);
-  if (normalized != "utf-8") {
-    throw std::invalid_argument("Unsupported encoding: " + encoding +
-                                " (only UTF-8 is supported)");
+  // Interning (off by default): strings up to internMaxBytes, 256 slots
+  // unless internEntries says otherwise. Capped at what a cache of short,
+  // repeated strings can use.
+  constexpr double kMaxInternBytes = 256;
+  constexpr double kMaxInternEntries = 4096;
+  size_t internMaxBytes = 0;
+  size_t internEntries = 0;
+  if (options.has_value() && options->internMaxBytes.has_value()) {
+    internMaxBytes = static_cast<size_t>(
+        std::clamp(options->internMaxBytes.value(), 0.0, kMaxInternBytes));
+    internEntries = static_cast<size_t>(
+        std::clamp(options->internEntries.value_or(256), 0.0,
+                   kMaxInternEntries));
   }
 
-  return std::make_shared<HybridTextDecoder>(encoding, fatal, ignoreBOM);
+  // The decoder resolves the label and throws for unsupported encodings.
+  return std::make_shared<HybridTextDecoder>(encoding, fatal, ignoreBOM,
+                                             internMaxBytes, internEntries);
 }
 
-std::string HybridTextEncoding::normalizeEncoding(const std::string &encoding) {
-  std::string normalized = encoding;
+std::shared_ptr<HybridNitroTextEncoderSpec> HybridTextEncoding::createEncoder() {
+  return std::make_shared<HybridTextEncoder>();
+}
+
+std::string
+HybridTextEncoding::decodeUTF8(const std::shared_ptr<ArrayBuffer> &input,
+                               std::optional<bool> fatal) {
+  std::string decoded;
+  uint8_t pending[4];
+  size_t pendingCount = 0;
+  bool bomSeen = false;
+  DecodeError error = nitrotextdecoder::decodeUTF8(
+      input ? input->data() : nullptr, input ? input->size() : 0,
+      fatal.value_or(false), /*ignoreBOM*/ false, /*stream*/ false,
+      /*bomSeen*/ false, &decoded, pending, &pendingCount, &bomSeen);
+  if (error != DecodeError::None) {
+    throw std::invalid_argument("The encoded data was not valid UTF-8");
+  }
+  return decoded;
+}
+
+// decodeUTF8 is bound raw so JS can pass any view and no ArrayBuffer wrapper
+// or std::string is created per call (Response.text() on small bodies).
+void HybridTextEncoding::loadHybridMethods() {
+  HybridObject::loadHybridMethods();
+  registerHybrids(this, [](Prototype &proto) {
+    proto.registerHybridMethod("createDecoder",
+                               &HybridTextEncoding::createDecoder);
+    proto.registerHybridMethod("createEncoder",
+                               &HybridTextEncoding::createEncoder);
+    proto.registerRawHybridMethod("decodeUTF8", 2,
+                                  &HybridTextEncoding::decodeUTF8Raw);
+    proto.registerHybridMethod("parseJSON", &HybridTextEncoding::parseJSON);
+    proto.registerHybridMethod("setParallelDecodeOptions",
+                               &HybridTextEncoding::setParallelDecodeOptions);
+  });
+}
 
-  // Convert to lowercase
-  std::transform(normalized.begin(), normalized.end(), normalized.begin(),
-                 ::tolower);
+jsi::Value HybridTextEncoding::decodeUTF8Raw(jsi::Runtime &runtime,
+                                             const jsi::Value & /*thisVal*/,
+                                             const jsi::Value *args,
+                                             size_t count) {
+  bool fatal = count > 1 && args[1].isBool() && args[1].getBool();
+  if (count == 0) {
+    return HybridTextDecoder::decodeUTF8Once(runtime, jsi::Value::undefined(),
+                                             fatal);
+  }
+  return HybridTextDecoder::decodeUTF8Once(runtime, args[0], fatal);
+}
 
-  // Handle common aliases
-  if (normalized == "utf8") {
-    return "utf-8";
+std::shared_ptr<Promise<std::shared_ptr<HybridNitroJSONDocumentSpec>>>
+HybridTextEncoding::parseJSON(const std::shared_ptr<ArrayBuffer> &input,
+                              std::optional<double> byteOffset,
+                              std::optional<double> byteLength) {
+  size_t bufferSize = input ? input->size() : 0;
+  size_t offset =
+      byteOffset.has_value() ? static_cast<size_t>(byteOffset.value()) : 0;
+  size_t length = byteLength.has_value()
+                      ? static_cast<size_t>(byteLength.value())
+                      : (bufferSize - offset);
+  if (offset > bufferSize || offset + length > bufferSize) [[unlikely]] {
+    throw std::invalid_argument("byteOffset + byteLength exceeds buffer size");
   }
 
-  return normalized;
+  // A JS-owned ArrayBuffer must not be read off the JS thread, so take a
+  // copy here; validation, string decoding and number parsing then run on
+  // Nitro's thread pool. JS builds the value with document.materialize().
+  auto bytes = ArrayBuffer::copy(input ? input->data() + offset : nullptr,
+                                 length);
+  return Promise<std::shared_ptr<HybridNitroJSONDocumentSpec>>::async(
+      [bytes]() -> std::shared_ptr<HybridNitroJSONDocumentSpec> {
+        auto document = std::make_shared<HybridJSONDocument>(bytes->size());
+        document->parse(bytes->data(), bytes->size());
+        return document;
+      });
+}
+
+void HybridTextEncoding::setParallelDecodeOptions(
+    std::optional<double> minBytes, std::optional<double> workers) {
+  if (minBytes.has_value()) {
+    setParallelDecodeMinBytes(
+        static_cast<size_t>(std::max(minBytes.value(), 0.0)));
+  }
+  if (workers.has_value()) {
+    // More threads than this only adds wake-up latency on phones.
+    constexpr double kMaxWorkers = 16;
+    setParallelDecodeWorkers(
+        static_cast<size_t>(std::clamp(workers.value(), 0.0, kMaxWorkers)));
+  }
 }
 
 } // namespace margelo::nitro::nitrotextdecoder
\ No newline at end of file
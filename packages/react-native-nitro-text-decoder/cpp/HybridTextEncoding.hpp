@@ -2,6 +2,7 @@
 
 #include "HybridNitroTextEncodingSpec.hpp"
 #include "HybridTextDecoder.hpp"
+#include "HybridTextEncoder.hpp"
 #include <memory>
 #include <string>
 
@@ -10,7 +11,8 @@ namespace margelo::nitro::nitrotextdecoder
 
   /**
    * C++ implementation of the `NitroTextEncoding` interface.
-   * Factory for creating text decoders with different encodings.
+   * Factory for creating text decoders with different encodings, and the
+   * (stateless, UTF-8 only) text encoder, plus the off-thread JSON parser.
    */
   class HybridTextEncoding : public HybridNitroTextEncodingSpec
   {
@@ -26,10 +28,26 @@ namespace margelo::nitro::nitrotextdecoder
     std::shared_ptr<HybridNitroTextDecoderSpec> createDecoder(
         const std::optional<std::string> &label,
         const std::optional<TextDecoderOptions> &options) override;
+    std::shared_ptr<HybridNitroTextEncoderSpec> createEncoder() override;
+    // Typed version (required by the spec; the raw method below is what JS
+    // actually calls).
+    std::string decodeUTF8(const std::shared_ptr<ArrayBuffer> &input,
+                           std::optional<bool> fatal) override;
+    std::shared_ptr<Promise<std::shared_ptr<HybridNitroJSONDocumentSpec>>>
+    parseJSON(const std::shared_ptr<ArrayBuffer> &input,
+              std::optional<double> byteOffset,
+              std::optional<double> byteLength) override;
+    void setParallelDecodeOptions(std::optional<double> minBytes,
+                                  std::optional<double> workers) override;
 
-  private:
-    // Helper methods
-    std::string normalizeEncoding(const std::string &encoding);
+    // Raw JSI decodeUTF8(input, fatal?): one-shot UTF-8 decode of an
+    // ArrayBuffer/TypedArray/DataView with no per-call decoder object.
+    jsi::Value decodeUTF8Raw(jsi::Runtime &runtime, const jsi::Value &thisVal,
+                             const jsi::Value *args, size_t count);
+
+  protected:
+    // Override to register decodeUTF8 as a raw method.
+    void loadHybridMethods() override;
   };
 
 } // namespace margelo::nitro::nitrotextdecoder
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+ * Byte span of an ArrayBuffer, TypedArray or DataView JSI argument.
+ *
+ * Raw JSI methods use this instead of going through a typed
+ * std::shared_ptr<ArrayBuffer> parameter so callers can pass views without
+ * a JS-side `.buffer.slice()` copy. Property names come from Nitro's
+ * per-runtime PropNameIDCache rather than a PropNameID built from a C
+ * string on every call.
+ *
+ * react-native-nitro-websockets carries a copy of this file; keep the two
+ * in sync.
+ */
+
+#pragma once
+
+#include <NitroModules/PropNameIDCache.hpp>
+#include <jsi/jsi.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::nitrotextdecoder {
+
+namespace jsi = facebook::jsi;
+
+struct ByteSpan {
+  uint8_t *data = nullptr;
+  size_t length = 0;
+};
+
+/**
+ * Resolve `value` to the bytes it covers, honouring a view's byteOffset and
+ * byteLength. Returns false for anything that is not an ArrayBuffer or
+ * ArrayBufferView; throws a JSError for a view that overruns its buffer.
+ * The span is only valid until control returns to JS.
+ */
+inline bool tryGetByteSpan(jsi::Runtime &runtime, const jsi::Value &value,
+                           ByteSpan *out) {
+  if (!value.isObject()) [[unlikely]] {
+    return false;
+  }
+  jsi::Object obj = value.getObject(runtime);
+  if (obj.isArrayBuffer(runtime)) {
+    jsi::ArrayBuffer ab = obj.getArrayBuffer(runtime);
+    out->data = ab.data(runtime);
+    out->length = ab.size(runtime);
+    return true;
+  }
+
+  jsi::Value bufferVal =
+      obj.getProperty(runtime, PropNameIDCache::get(runtime, "buffer"));
+  if (!bufferVal.isObject()) [[unlikely]] {
+    return false;
+  }
+  jsi::Object bufferObj = bufferVal.getObject(runtime);
+  if (!bufferObj.isArrayBuffer(runtime)) [[unlikely]] {
+    return false;
+  }
+  jsi::ArrayBuffer ab = bufferObj.getArrayBuffer(runtime);
+  size_t fullSize = ab.size(runtime);
+
+  jsi::Value offsetVal =
+      obj.getProperty(runtime, PropNameIDCache::get(runtime, "byteOffset"));
+  jsi::Value lengthVal =
+      obj.getProperty(runtime, PropNameIDCache::get(runtime, "byteLength"));
+  size_t offset =
+      offsetVal.isNumber() ? static_cast<size_t>(offsetVal.asNumber()) : 0;
+  size_t length = lengthVal.isNumber()
+                      ? static_cast<size_t>(lengthVal.asNumber())
+                      : fullSize;
+  if (offset > fullSize || length > fullSize - offset) [[unlikely]] {
+    throw jsi::JSError(runtime, "byteOffset + byteLength exceeds buffer size");
+  }
+  out->data = ab.data(runtime) + offset;
+  out->length = length;
+  return true;
+}
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -0,0 +1,487 @@
+/*
+ * Compact JSON tape (simdjson-style) for parsing off the JS thread.
+ */
+
+#include "JSONTape.hpp"
+#include "TextDecoderUtils.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "simdutf.h"
+
+namespace margelo::nitro::nitrotextdecoder {
+
+namespace {
+
+// String refs: offset into the string arena in the low 48 bits, flags above.
+constexpr uint64_t kOffsetMask = (1ULL << 48) - 1;
+constexpr uint64_t kAsciiFlag = 1ULL << 48;
+constexpr uint64_t kWtf8Flag = 1ULL << 49;
+
+// Same nesting limit as Hermes' JSON.parse.
+constexpr size_t kMaxDepth = 1024;
+
+constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                             1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                             1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+inline uint64_t tapeWord(char tag, uint64_t payload) {
+  return (static_cast<uint64_t>(static_cast<uint8_t>(tag)) << 56) | payload;
+}
+
+inline bool isDigit(uint8_t c) { return c >= '0' && c <= '9'; }
+
+inline int hexValue(uint8_t c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// True if any of the 8 bytes is '"', '\\' or a control character.
+inline bool hasStringSpecial(uint64_t w) {
+  constexpr uint64_t ones = 0x0101010101010101ULL;
+  constexpr uint64_t highs = 0x8080808080808080ULL;
+  uint64_t quote = w ^ (ones * '"');
+  uint64_t slash = w ^ (ones * '\\');
+  uint64_t special = ((quote - ones) & ~quote) | ((slash - ones) & ~slash) |
+                     (w - ones * 0x20);
+  return (special & ~w & highs) != 0;
+}
+
+// Append a code point (surrogates included, as generalized UTF-8).
+inline void appendUTF8(std::vector<char> &out, uint32_t cp) {
+  if (cp < 0x80) {
+    out.push_back(static_cast<char>(cp));
+  } else if (cp < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else if (cp < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  }
+}
+
+inline uint64_t hashBytes(const char *data, size_t length) {
+  uint64_t h = 0xCBF29CE484222325ULL; // FNV-1a
+  for (size_t i = 0; i < length; ++i) {
+    h = (h ^ static_cast<uint8_t>(data[i])) * 0x100000001B3ULL;
+  }
+  return h;
+}
+
+} // namespace
+
+class JSONTape::Parser {
+public:
+  Parser(JSONTape &tape, const uint8_t *bytes, size_t length)
+      : _tape(tape), _begin(bytes), _p(bytes), _end(bytes + length) {}
+
+  void run() {
+    enum class State { Value, Key, AfterValue };
+    std::vector<size_t> stack;
+    std::vector<uint32_t> counts;
+    State state = State::Value;
+
+    skipWhitespace();
+    while (true) {
+      switch (state) {
+      case State::Value: {
+        if (_p == _end) fail("Unexpected end of input");
+        uint8_t c = *_p;
+        if (c == '{' || c == '[') {
+          if (stack.size() >= kMaxDepth) fail("Nesting too deep");
+          ++_p;
+          stack.push_back(_tape._tape.size());
+          counts.push_back(0);
+          _tape._tape.push_back(tapeWord(static_cast<char>(c), 0));
+          skipWhitespace();
+          uint8_t close = c == '{' ? '}' : ']';
+          if (_p < _end && *_p == close) {
+            ++_p;
+            closeContainer(stack, counts, /*empty*/ true);
+            state = State::AfterValue;
+          } else {
+            state = c == '{' ? State::Key : State::Value;
+          }
+          continue;
+        }
+        if (c == '"') {
+          _tape._tape.push_back(tapeWord('"', parseString()));
+        } else if (c == '-' || isDigit(c)) {
+          double value = parseNumber();
+          uint64_t bits;
+          std::memcpy(&bits, &value, sizeof(bits));
+          _tape._tape.push_back(tapeWord('d', 0));
+          _tape._tape.push_back(bits);
+        } else if (c == 't') {
+          expectLiteral("true");
+          _tape._tape.push_back(tapeWord('t', 0));
+        } else if (c == 'f') {
+          expectLiteral("false");
+          _tape._tape.push_back(tapeWord('f', 0));
+        } else if (c == 'n') {
+          expectLiteral("null");
+          _tape._tape.push_back(tapeWord('n', 0));
+        } else {
+          fail("Unexpected token");
+        }
+        state = State::AfterValue;
+        continue;
+      }
+
+      case State::Key: {
+        skipWhitespace();
+        if (_p == _end || *_p != '"') fail("Expected property name");
+        _tape._tape.push_back(tapeWord('k', internKey(parseString())));
+        skipWhitespace();
+        if (_p == _end || *_p != ':') fail("Expected ':'");
+        ++_p;
+        skipWhitespace();
+        state = State::Value;
+        continue;
+      }
+
+      case State::AfterValue: {
+        skipWhitespace();
+        if (stack.empty()) {
+          if (_p != _end) fail("Unexpected token after JSON value");
+          return;
+        }
+        ++counts.back();
+        bool isObject = _tape.tag(stack.back()) == '{';
+        if (_p < _end && *_p == ',') {
+          ++_p;
+          skipWhitespace();
+          state = isObject ? State::Key : State::Value;
+          continue;
+        }
+        if (_p < _end && *_p == (isObject ? '}' : ']')) {
+          ++_p;
+          closeContainer(stack, counts, /*empty*/ false);
+          continue;
+        }
+        fail(isObject ? "Expected ',' or '}'" : "Expected ',' or ']'");
+      }
+      }
+    }
+  }
+
+private:
+  [[noreturn]] void fail(const char *what) {
+    throw std::invalid_argument("JSON Parse error: " + std::string(what) +
+                                " at position " +
+                                std::to_string(_p - _begin));
+  }
+
+  void skipWhitespace() {
+    while (_p < _end &&
+           (*_p == ' ' || *_p == '\n' || *_p == '\r' || *_p == '\t')) {
+      ++_p;
+    }
+  }
+
+  void expectLiteral(const char *literal) {
+    size_t n = std::strlen(literal);
+    if (static_cast<size_t>(_end - _p) < n || std::memcmp(_p, literal, n) != 0) {
+      fail("Unexpected token");
+    }
+    _p += n;
+  }
+
+  void closeContainer(std::vector<size_t> &stack, std::vector<uint32_t> &counts,
+                      bool empty) {
+    size_t start = stack.back();
+    uint64_t count = empty ? 0 : counts.back();
+    if (count > kMaxCount) count = kMaxCount;
+    size_t end = _tape._tape.size();
+    char open = _tape.tag(start);
+    _tape._tape[start] = tapeWord(open, (count << 32) | end);
+    _tape._tape.push_back(tapeWord(open == '{' ? '}' : ']', start));
+    stack.pop_back();
+    counts.pop_back();
+  }
+
+  // Decode the string at _p into the arena; returns its ref.
+  uint64_t parseString() {
+    std::vector<char> &arena = _tape._strings;
+    ++_p; // opening quote
+    size_t header = arena.size();
+    arena.resize(header + sizeof(uint32_t));
+    bool ascii = true;
+    bool wtf8 = false;
+    const uint8_t *run = _p;
+    auto flushRun = [&]() {
+      arena.insert(arena.end(), run, _p);
+    };
+
+    while (true) {
+      while (_end - _p >= 8) {
+        uint64_t w;
+        std::memcpy(&w, _p, sizeof(w));
+        if (hasStringSpecial(w)) break;
+        ascii &= (w & 0x8080808080808080ULL) == 0;
+        _p += 8;
+      }
+      if (_p == _end) fail("Unterminated string");
+      uint8_t c = *_p;
+      if (c == '"') break;
+      if (c < 0x20) fail("Invalid control character in string");
+      if (c != '\\') {
+        ascii &= c < 0x80;
+        ++_p;
+        continue;
+      }
+
+      flushRun();
+      ++_p;
+      if (_p == _end) fail("Unterminated string");
+      uint8_t e = *_p++;
+      switch (e) {
+      case '"': arena.push_back('"'); break;
+      case '\\': arena.push_back('\\'); break;
+      case '/': arena.push_back('/'); break;
+      case 'b': arena.push_back('\b'); break;
+      case 'f': arena.push_back('\f'); break;
+      case 'n': arena.push_back('\n'); break;
+      case 'r': arena.push_back('\r'); break;
+      case 't': arena.push_back('\t'); break;
+      case 'u': {
+        uint32_t cp = parseHex4();
+        if (isHighSurrogate(cp) && _end - _p >= 6 && _p[0] == '\\' &&
+            _p[1] == 'u') {
+          const uint8_t *save = _p;
+          _p += 2;
+          uint32_t low = parseHex4();
+          if (isLowSurrogate(low)) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+          } else {
+            _p = save; // lone high surrogate; re-read the next escape
+          }
+        }
+        if (cp >= 0xD800 && cp <= 0xDFFF) wtf8 = true;
+        ascii &= cp < 0x80;
+        appendUTF8(arena, cp);
+        break;
+      }
+      default:
+        --_p;
+        fail("Invalid escape");
+      }
+      run = _p;
+    }
+    flushRun();
+    ++_p; // closing quote
+
+    uint32_t length = static_cast<uint32_t>(arena.size() - header -
+                                            sizeof(uint32_t));
+    std::memcpy(arena.data() + header, &length, sizeof(length));
+    return header | (ascii ? kAsciiFlag : 0) | (wtf8 ? kWtf8Flag : 0);
+  }
+
+  uint32_t parseHex4() {
+    if (_end - _p < 4) fail("Invalid \\u escape");
+    uint32_t cp = 0;
+    for (int i = 0; i < 4; ++i) {
+      int v = hexValue(_p[i]);
+      if (v < 0) fail("Invalid \\u escape");
+      cp = (cp << 4) | static_cast<uint32_t>(v);
+    }
+    _p += 4;
+    return cp;
+  }
+
+  // Deduplicate object keys so the JS side creates one PropNameID per
+  // distinct name. Open addressing over key ids; the arena copy of a
+  // repeated key is dropped again.
+  uint32_t internKey(uint64_t ref) {
+    StringRef key = _tape.stringAt(ref);
+    std::vector<uint32_t> &slots = _tape._keySlots;
+    if (slots.empty()) slots.assign(64, 0);
+    if (_tape._keys.size() * 2 >= slots.size()) growSlots();
+    size_t mask = slots.size() - 1;
+    for (size_t i = hashBytes(key.data, key.length) & mask;; i = (i + 1) & mask) {
+      uint32_t slot = slots[i];
+      if (slot == 0) {
+        uint32_t id = static_cast<uint32_t>(_tape._keys.size());
+        _tape._keys.push_back(ref);
+        slots[i] = id + 1;
+        return id;
+      }
+      StringRef other = _tape.key(slot - 1);
+      if (other.length == key.length && other.wtf8 == key.wtf8 &&
+          std::memcmp(other.data, key.data, key.length) == 0) {
+        _tape._strings.resize(ref & kOffsetMask);
+        return slot - 1;
+      }
+    }
+  }
+
+  void growSlots() {
+    std::vector<uint32_t> slots(_tape._keySlots.size() * 2, 0);
+    size_t mask = slots.size() - 1;
+    for (uint32_t id = 0; id < _tape._keys.size(); ++id) {
+      StringRef key = _tape.key(id);
+      size_t i = hashBytes(key.data, key.length) & mask;
+      while (slots[i] != 0) i = (i + 1) & mask;
+      slots[i] = id + 1;
+    }
+    _tape._keySlots.swap(slots);
+  }
+
+  // Exact for up to 19 significant digits with |exponent| <= 22 (Clinger's
+  // fast path); everything else goes through strtod.
+  double parseNumber() {
+    const uint8_t *start = _p;
+    bool negative = *_p == '-';
+    if (negative) ++_p;
+    if (_p == _end || !isDigit(*_p)) fail("Invalid number");
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int64_t exponent = 0;
+    bool truncated = false;
+    auto addDigit = [&](uint8_t c, bool fraction) {
+      if (mantissa == 0 && c == '0') {
+        if (fraction) --exponent;
+        return;
+      }
+      if (digits < 19) {
+        mantissa = mantissa * 10 + (c - '0');
+        ++digits;
+        if (fraction) --exponent;
+      } else {
+        truncated = true;
+        if (!fraction) ++exponent;
+      }
+    };
+
+    if (*_p == '0') {
+      ++_p;
+    } else {
+      while (_p < _end && isDigit(*_p)) addDigit(*_p++, false);
+    }
+    if (_p < _end && *_p == '.') {
+      ++_p;
+      if (_p == _end || !isDigit(*_p)) fail("Invalid number");
+      while (_p < _end && isDigit(*_p)) addDigit(*_p++, true);
+    }
+    if (_p < _end && (*_p == 'e' || *_p == 'E')) {
+      ++_p;
+      bool negativeExponent = false;
+      if (_p < _end && (*_p == '+' || *_p == '-')) {
+        negativeExponent = *_p == '-';
+        ++_p;
+      }
+      if (_p == _end || !isDigit(*_p)) fail("Invalid number");
+      int64_t e = 0;
+      while (_p < _end && isDigit(*_p)) {
+        if (e < 100000) e = e * 10 + (*_p - '0');
+        ++_p;
+      }
+      exponent += negativeExponent ? -e : e;
+    }
+
+    double value;
+    if (mantissa == 0 && !truncated) {
+      value = 0.0;
+    } else if (!truncated && mantissa <= (1ULL << 53) && exponent >= -22 &&
+               exponent <= 22) {
+      value = static_cast<double>(mantissa);
+      value = exponent < 0 ? value / kPow10[-exponent]
+                           : value * kPow10[exponent];
+    } else {
+      std::string text(reinterpret_cast<const char *>(start), _p - start);
+      return std::strtod(text.c_str(), nullptr);
+    }
+    return negative ? -value : value;
+  }
+
+  JSONTape &_tape;
+  const uint8_t *_begin;
+  const uint8_t *_p;
+  const uint8_t *_end;
+};
+
+void JSONTape::parse(const uint8_t *bytes, size_t length) {
+  _tape.clear();
+  _strings.clear();
+  _keys.clear();
+  _keySlots.clear();
+  _tape.reserve(length / 4 + 2);
+  _strings.reserve(length / 2);
+
+  if (length >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+    bytes += 3;
+    length -= 3;
+  }
+  if (simdutf::validate_utf8(reinterpret_cast<const char *>(bytes), length))
+      [[likely]] {
+    Parser(*this, bytes, length).run();
+    return;
+  }
+
+  // Ill-formed UTF-8: repair first, as TextDecoder would before JSON.parse.
+  std::string repaired;
+  uint8_t pendingBytes[4];
+  size_t pendingCount = 0;
+  bool bomSeen = false;
+  decodeUTF8(bytes, length, /*fatal*/ false, /*ignoreBOM*/ true,
+             /*stream*/ false, /*bomSeen*/ false, &repaired, pendingBytes,
+             &pendingCount, &bomSeen);
+  Parser(*this, reinterpret_cast<const uint8_t *>(repaired.data()),
+         repaired.size())
+      .run();
+}
+
+size_t JSONTape::next(size_t index) const {
+  switch (tag(index)) {
+  case '{':
+  case '[':
+    return after(index);
+  case 'd':
+    return index + 2;
+  default:
+    return index + 1;
+  }
+}
+
+bool JSONTape::findKey(const char *data, size_t length, uint32_t *keyId) const {
+  if (_keySlots.empty()) return false;
+  size_t mask = _keySlots.size() - 1;
+  for (size_t i = hashBytes(data, length) & mask;; i = (i + 1) & mask) {
+    uint32_t slot = _keySlots[i];
+    if (slot == 0) return false;
+    StringRef key = this->key(slot - 1);
+    if (!key.wtf8 && key.length == length &&
+        std::memcmp(key.data, data, length) == 0) {
+      *keyId = slot - 1;
+      return true;
+    }
+  }
+}
+
+double JSONTape::number(size_t index) const {
+  double value;
+  std::memcpy(&value, &_tape[index + 1], sizeof(value));
+  return value;
+}
+
+JSONTape::StringRef JSONTape::stringAt(uint64_t ref) const {
+  size_t offset = static_cast<size_t>(ref & kOffsetMask);
+  uint32_t length;
+  std::memcpy(&length, _strings.data() + offset, sizeof(length));
+  return StringRef{_strings.data() + offset + sizeof(uint32_t), length,
+                   (ref & kAsciiFlag) != 0, (ref & kWtf8Flag) != 0};
+}
+
+} // namespace margelo::nitro::nitrotextdecoder
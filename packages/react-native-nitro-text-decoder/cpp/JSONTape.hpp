@@ -0,0 +1,94 @@
+/*
+ * Compact JSON tape (simdjson-style) for parsing off the JS thread.
+ *
+ * The parser validates the document and decodes strings and numbers into a
+ * flat array of 64-bit words; turning it into JS values is then a single
+ * linear walk on the JS thread (see HybridJSONDocument).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitrotextdecoder {
+
+/**
+ * Tape layout: every word is `tag << 56 | payload`.
+ *
+ *   '{' / '['  payload = count << 32 | index of the matching '}' / ']'
+ *              (count saturates at kMaxCount; walk the children if hit)
+ *   '}' / ']'  payload = index of the matching '{' / '['
+ *   'k'        object key; payload = key id (see key())
+ *   '"'        string; payload = string ref (see string())
+ *   'd'        number; the following word holds the IEEE-754 bits
+ *   't' 'f' 'n' true / false / null
+ *
+ * Object members are laid out as key, value, key, value, ...
+ */
+class JSONTape {
+public:
+  struct StringRef {
+    const char *data;
+    size_t length;
+    bool ascii; // only 0x00-0x7F
+    bool wtf8;  // contains an escaped lone surrogate (generalized UTF-8)
+  };
+
+  static constexpr uint32_t kMaxCount = 0xFFFFFF;
+
+  // Parse a UTF-8 JSON document. Ill-formed UTF-8 is replaced with U+FFFD
+  // (as when decoding with TextDecoder first); a leading BOM is skipped.
+  // Throws std::invalid_argument with a JSON.parse-like message on error.
+  void parse(const uint8_t *bytes, size_t length);
+
+  size_t size() const { return _tape.size(); }
+  char tag(size_t index) const { return static_cast<char>(_tape[index] >> 56); }
+  uint64_t payload(size_t index) const {
+    return _tape[index] & 0x00FFFFFFFFFFFFFFULL;
+  }
+
+  // For '{' / '[': index one past the matching close, and the child count
+  // (members for objects) or kMaxCount if it did not fit.
+  size_t after(size_t index) const {
+    return static_cast<size_t>(payload(index) & 0xFFFFFFFF) + 1;
+  }
+  uint32_t count(size_t index) const {
+    return static_cast<uint32_t>(payload(index) >> 32);
+  }
+
+  // Index of the next sibling of the value starting at `index`.
+  size_t next(size_t index) const;
+
+  double number(size_t index) const;
+  StringRef string(size_t index) const { return stringAt(payload(index)); }
+  StringRef key(uint32_t keyId) const { return stringAt(_keys[keyId]); }
+  size_t keyCount() const { return _keys.size(); }
+
+  // Look up the id of a (well-formed UTF-8) object key.
+  bool findKey(const char *data, size_t length, uint32_t *keyId) const;
+
+  // Heap bytes held by the tape, for GC pressure hints.
+  size_t memorySize() const {
+    return _tape.capacity() * sizeof(uint64_t) + _strings.capacity() +
+           _keys.capacity() * sizeof(uint64_t) +
+           _keySlots.capacity() * sizeof(uint32_t);
+  }
+
+private:
+  class Parser;
+
+  StringRef stringAt(uint64_t ref) const;
+
+  std::vector<uint64_t> _tape;
+  // Decoded strings: [uint32 length][bytes] each.
+  std::vector<char> _strings;
+  // Unique object keys (string refs); the tape refers to them by id.
+  std::vector<uint64_t> _keys;
+  // Open-addressing hash of key ids (id + 1; 0 = empty), kept for findKey().
+  std::vector<uint32_t> _keySlots;
+};
+
+} // namespace margelo::nitro::nitrotextdecoder
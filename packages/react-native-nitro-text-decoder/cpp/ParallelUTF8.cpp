@@ -0,0 +1,178 @@
+/*
+ * Multi-core UTF-8 -> UTF-16 transcoding for very large decode inputs.
+ */
+
+#include "ParallelUTF8.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "simdutf.h"
+
+namespace margelo::nitro::nitrotextdecoder {
+
+namespace {
+
+constexpr size_t kDefaultMinBytes = 1 << 20;
+// Below this a segment is not worth waking a thread for.
+constexpr size_t kMinSegmentBytes = 256 * 1024;
+
+size_t defaultWorkerCount() {
+  unsigned cores = std::thread::hardware_concurrency();
+  return cores > 1 ? std::min<size_t>(cores - 1, 3) : 0;
+}
+
+std::atomic<size_t> gMinBytes{kDefaultMinBytes};
+std::atomic<size_t> gWorkers{defaultWorkerCount()};
+
+// Fork-join pool: run(n, task) calls task(0..n-1) across the workers and
+// the calling thread and returns once all of them finished. Threads are
+// started lazily and live for the rest of the process. One job runs at a
+// time; a concurrent caller (another JS runtime) runs its tasks inline.
+class WorkerPool {
+public:
+  static WorkerPool &shared() {
+    // Leaked on purpose: workers are never joined at exit.
+    static auto *pool = new WorkerPool();
+    return *pool;
+  }
+
+  void run(size_t workers, size_t tasks,
+           const std::function<void(size_t)> &task) {
+    std::unique_lock<std::mutex> runLock(_runMutex, std::try_to_lock);
+    if (!runLock.owns_lock() || workers == 0 || tasks <= 1) {
+      for (size_t i = 0; i < tasks; ++i) task(i);
+      return;
+    }
+
+    Job job{&task, tasks};
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      while (_threads < workers) {
+        std::thread(&WorkerPool::workerLoop, this, _threads++, _generation)
+            .detach();
+      }
+      _active = workers;
+      _job = &job;
+      ++_generation;
+    }
+    _wake.notify_all();
+    runTasks(job);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _job = nullptr; // late wakers must not pick this job up any more
+    _done.wait(lock, [&] { return job.inside == 0; });
+  }
+
+private:
+  struct Job {
+    const std::function<void(size_t)> *task;
+    size_t count;
+    std::atomic<size_t> next{0};
+    size_t inside = 0; // workers in runTasks(); guarded by _mutex
+  };
+
+  static void runTasks(Job &job) {
+    for (size_t i = job.next.fetch_add(1); i < job.count;
+         i = job.next.fetch_add(1)) {
+      (*job.task)(i);
+    }
+  }
+
+  void workerLoop(size_t index, uint64_t seen) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+      _wake.wait(lock, [&] { return _generation != seen; });
+      seen = _generation;
+      Job *job = _job;
+      if (job == nullptr || index >= _active) continue;
+      ++job->inside;
+      lock.unlock();
+      runTasks(*job);
+      lock.lock();
+      if (--job->inside == 0) _done.notify_all();
+    }
+  }
+
+  std::mutex _runMutex;
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+  Job *_job = nullptr;
+  uint64_t _generation = 0;
+  size_t _threads = 0;
+  size_t _active = 0;
+};
+
+} // namespace
+
+void setParallelDecodeMinBytes(size_t minBytes) {
+  gMinBytes.store(minBytes, std::memory_order_relaxed);
+}
+
+void setParallelDecodeWorkers(size_t workers) {
+  gWorkers.store(workers, std::memory_order_relaxed);
+}
+
+size_t parallelDecodeMinBytes() {
+  if (gWorkers.load(std::memory_order_relaxed) == 0) return SIZE_MAX;
+  return gMinBytes.load(std::memory_order_relaxed);
+}
+
+bool ParallelUTF8Decode::validate(const uint8_t *bytes, size_t length) {
+  size_t workers = gWorkers.load(std::memory_order_relaxed);
+  size_t count =
+      std::clamp<size_t>(length / kMinSegmentBytes, 1, workers + 1);
+
+  // Cut at lead bytes: well-formed UTF-8 has at most three continuation
+  // bytes in a row, so a cut that still lands on one means the input is
+  // ill-formed and that segment will fail validation.
+  _segments.clear();
+  size_t start = 0;
+  for (size_t i = 1; i <= count; ++i) {
+    size_t end = i == count ? length : length / count * i;
+    for (int k = 0; k < 3 && end < length && (bytes[end] & 0xC0) == 0x80;
+         ++k) {
+      ++end;
+    }
+    end = std::max(end, start);
+    _segments.push_back(Segment{bytes + start, end - start, 0, 0, false, false});
+    start = end;
+  }
+
+  WorkerPool::shared().run(workers, _segments.size(), [this](size_t i) {
+    Segment &s = _segments[i];
+    const auto *data = reinterpret_cast<const char *>(s.bytes);
+    s.valid = simdutf::validate_utf8(data, s.length);
+    if (s.valid) {
+      s.units = simdutf::utf16_length_from_utf8(data, s.length);
+    }
+  });
+
+  _utf16Length = 0;
+  for (Segment &s : _segments) {
+    if (!s.valid) return false;
+    s.outOffset = _utf16Length;
+    _utf16Length += s.units;
+  }
+  return true;
+}
+
+bool ParallelUTF8Decode::convert(char16_t *out) {
+  size_t workers = gWorkers.load(std::memory_order_relaxed);
+  WorkerPool::shared().run(workers, _segments.size(), [&](size_t i) {
+    Segment &s = _segments[i];
+    s.converted = simdutf::convert_valid_utf8_to_utf16le(
+                      reinterpret_cast<const char *>(s.bytes), s.length,
+                      out + s.outOffset) == s.units;
+  });
+  return std::all_of(_segments.begin(), _segments.end(),
+                     [](const Segment &s) { return s.converted; });
+}
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -0,0 +1,57 @@
+/*
+ * Multi-core UTF-8 -> UTF-16 transcoding for very large decode inputs.
+ *
+ * The input is cut into one segment per thread at code-point boundaries.
+ * Each segment is validated and sized in parallel, then transcoded in
+ * parallel into its own (disjoint) range of the output buffer, so the
+ * caller can hand the result to createFromUtf16 once.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::nitrotextdecoder {
+
+/**
+ * Tunables. Inputs of at least `minBytes` are decoded on `workers` pool
+ * threads plus the calling thread; `workers == 0` disables the parallel
+ * path. Defaults: 1 MiB, and up to 3 workers depending on the core count.
+ */
+void setParallelDecodeMinBytes(size_t minBytes);
+void setParallelDecodeWorkers(size_t workers);
+
+// Smallest input that takes the parallel path (SIZE_MAX when disabled).
+size_t parallelDecodeMinBytes();
+
+class ParallelUTF8Decode {
+public:
+  // Split, validate and size `bytes`. Returns false if the input is not
+  // well-formed UTF-8 (callers fall back to the single-threaded path).
+  bool validate(const uint8_t *bytes, size_t length);
+
+  // UTF-16 units produced by convert(); valid after validate() succeeded.
+  size_t utf16Length() const { return _utf16Length; }
+
+  // Transcode the validated input into `out` (utf16Length() units). False if
+  // a segment wrote a different number of units than validate() counted;
+  // `out` is then unusable and the caller transcodes on its own thread.
+  bool convert(char16_t *out);
+
+private:
+  struct Segment {
+    const uint8_t *bytes;
+    size_t length;
+    size_t outOffset;
+    size_t units;
+    bool valid;
+    bool converted;
+  };
+
+  std::vector<Segment> _segments;
+  size_t _utf16Length = 0;
+};
+
+} // namespace margelo::nitro::nitrotextdecoder
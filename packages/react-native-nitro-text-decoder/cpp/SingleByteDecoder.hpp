@@ -0,0 +1,39 @@
+/*
+ * WHATWG single-byte (legacy) encodings for TextDecoder: windows-125x,
+ * ISO-8859-x, KOI8, IBM866 and the Mac code pages.
+ *
+ * Tables follow https://encoding.spec.whatwg.org/#legacy-single-byte-encodings
+ * (bytes 0x00-0x7F are ASCII in every one of them; only 0x80-0xFF are listed).
+ */
+
+#pragma once
+
+#include "TextDecoderUtils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitrotextdecoder {
+
+inline bool isSingleByteEncoding(TextDecoderEncoding encoding) {
+  return encoding >= TextDecoderEncoding::IBM866 &&
+         encoding < TextDecoderEncoding::_count;
+}
+
+// Resolve an already trimmed, lower-cased label to a single-byte encoding.
+std::optional<TextDecoderEncoding>
+parseSingleByteLabel(const std::string &label);
+
+// Canonical WHATWG name of a single-byte encoding.
+const char *getSingleByteEncodingName(TextDecoderEncoding encoding);
+
+// Decode `length` bytes into `out` (exactly `length` UTF-16 units). Bytes are
+// widened 1:1 with simdutf's Latin-1 conversion, then only the high bytes are
+// patched through the encoding's table. Returns false if any byte has no
+// mapping (it is decoded as U+FFFD).
+bool decodeSingleByte(TextDecoderEncoding encoding, const uint8_t *bytes,
+                      size_t length, char16_t *out);
+
+} // namespace margelo::nitro::nitrotextdecoder
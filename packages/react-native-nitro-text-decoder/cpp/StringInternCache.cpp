@@ -0,0 +1,82 @@
+/*
+ * Bounded cache of recently decoded short strings.
+ */
+
+#include "StringInternCache.hpp"
+
+#include <cstring>
+
+namespace margelo::nitro::nitrotextdecoder {
+
+StringInternCache::StringInternCache(size_t maxBytes, size_t entries)
+    : _maxBytes(maxBytes) {
+  size_t capacity = 1;
+  while (capacity < entries) capacity <<= 1;
+  _mask = capacity - 1;
+  _slots.resize(capacity);
+}
+
+// Word-at-a-time multiply/xor-shift mix; keys are short and collisions are
+// resolved by comparing bytes, so speed matters more than quality here.
+uint64_t StringInternCache::hashBytes(const uint8_t *bytes, size_t length) {
+  uint64_t h = 0x9E3779B97F4A7C15ull ^ length;
+  while (length >= 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes, 8);
+    h = (h ^ word) * 0xFF51AFD7ED558CCDull;
+    h ^= h >> 32;
+    bytes += 8;
+    length -= 8;
+  }
+  uint64_t tail = 0;
+  std::memcpy(&tail, bytes, length);
+  h = (h ^ tail) * 0xC4CEB9FE1A85EC53ull;
+  return h ^ (h >> 29);
+}
+
+std::optional<jsi::Value> StringInternCache::find(jsi::Runtime &runtime,
+                                                  const uint8_t *bytes,
+                                                  size_t length) {
+  _lastHash = hashBytes(bytes, length);
+  size_t index = _lastHash & _mask;
+  const Slot &slot = _slots[index];
+  // A reference whose runtime was torn down reads as empty, so a new runtime
+  // that reuses the old one's address cannot see its strings.
+  if (slot.runtime == &runtime && slot.value && slot.hash == _lastHash &&
+      slot.length == length &&
+      std::memcmp(slot.key.data(), bytes, length) == 0) {
+    ++_hits;
+    return jsi::Value(runtime, *slot.value);
+  }
+  ++_misses;
+  return std::nullopt;
+}
+
+void StringInternCache::store(jsi::Runtime &runtime, const uint8_t *bytes,
+                              size_t length, const jsi::Value &value) {
+  size_t index = _lastHash & _mask;
+  Slot &slot = _slots[index];
+  if (slot.runtime != nullptr) {
+    ++_evictions;
+  } else {
+    ++_entries;
+  }
+  auto cache = JSICache::getOrCreateCache(runtime);
+  slot.runtime = &runtime;
+  slot.hash = _lastHash;
+  slot.length = static_cast<uint32_t>(length);
+  slot.value = cache.makeShared(jsi::Value(runtime, value));
+  slot.key.assign(bytes, bytes + length);
+}
+
+StringInternCache::Stats StringInternCache::stats() const {
+  return Stats{_hits, _misses, _evictions, _entries};
+}
+
+void StringInternCache::resetStats() {
+  _hits = 0;
+  _misses = 0;
+  _evictions = 0;
+}
+
+} // namespace margelo::nitro::nitrotextdecoder
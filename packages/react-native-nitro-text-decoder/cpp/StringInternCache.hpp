@@ -0,0 +1,73 @@
+/*
+ * Bounded cache of recently decoded short strings, keyed by their input
+ * bytes. Used by HybridTextDecoder's opt-in interning mode, where a feed
+ * repeats the same small messages ("ping", "ack", event names, ...).
+ */
+
+#pragma once
+
+#include <NitroModules/JSICache.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <jsi/jsi.h>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro::nitrotextdecoder {
+
+namespace jsi = facebook::jsi;
+
+/**
+ * Direct-mapped: each input hashes to one slot, and a store replaces
+ * whatever the slot held. Strings are held through the runtime's JSICache,
+ * so they are released when that runtime goes away instead of outliving it;
+ * a slot only hits for the runtime that stored it, and only while its
+ * reference is still alive.
+ */
+class StringInternCache {
+public:
+  // Inputs longer than `maxBytes` are never cached. `entries` is rounded up
+  // to a power of two.
+  StringInternCache(size_t maxBytes, size_t entries);
+
+  size_t maxBytes() const { return _maxBytes; }
+
+  // The cached string for `bytes`, or std::nullopt (counted as a miss).
+  std::optional<jsi::Value> find(jsi::Runtime &runtime, const uint8_t *bytes,
+                                 size_t length);
+
+  // Remember `value` as the decoding of `bytes` (the last find() missed).
+  void store(jsi::Runtime &runtime, const uint8_t *bytes, size_t length,
+             const jsi::Value &value);
+
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entries;
+  };
+  Stats stats() const;
+  void resetStats();
+
+private:
+  struct Slot {
+    uint64_t hash = 0;
+    uint32_t length = 0;
+    jsi::Runtime *runtime = nullptr;
+    BorrowingReference<jsi::Value> value;
+    std::vector<uint8_t> key; // sized on store(), so idle slots cost nothing
+  };
+
+  static uint64_t hashBytes(const uint8_t *bytes, size_t length);
+
+  size_t _maxBytes;
+  size_t _mask;
+  std::vector<Slot> _slots;
+  uint64_t _lastHash = 0; // hash computed by the last find()
+  uint64_t _hits = 0;
+  uint64_t _misses = 0;
+  uint64_t _evictions = 0;
+  size_t _entries = 0;
+};
+
+} // namespace margelo::nitro::nitrotextdecoder
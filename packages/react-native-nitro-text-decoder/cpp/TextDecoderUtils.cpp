@@ -7,10 +7,13 @@
  */
 
  #include "TextDecoderUtils.hpp"
+ #include "SingleByteDecoder.hpp"
 
  #include <algorithm>
  #include <cctype>
  #include <cstring>
+
+ #include "simdutf.h"
  
  namespace margelo::nitro::nitrotextdecoder {
  
@@ -106,6 +109,35 @@
    return maxLen;
  }
  
+ // Length (0-3) of a trailing sequence that could still be completed by the
+ // next chunk.
+ size_t incompleteUTF8TailLength(const uint8_t *bytes, size_t length) {
+   // Up to 3 bytes for a 4-byte sequence.
+   for (size_t tailLen = std::min(length, size_t(3)); tailLen > 0; --tailLen) {
+     if (isValidPartialUTF8(bytes + length - tailLen, tailLen)) {
+       return tailLen;
+     }
+   }
+   return 0;
+ }
+
+ // Decode one well-formed UTF-8 sequence (caller has validated it).
+ char32_t decodeUTF8CodePoint(const uint8_t *bytes, size_t length) {
+   switch (length) {
+     case 1:
+       return bytes[0];
+     case 2:
+       return (char32_t(bytes[0] & 0x1F) << 6) | (bytes[1] & 0x3F);
+     case 3:
+       return (char32_t(bytes[0] & 0x0F) << 12) |
+              (char32_t(bytes[1] & 0x3F) << 6) | (bytes[2] & 0x3F);
+     default:
+       return (char32_t(bytes[0] & 0x07) << 18) |
+              (char32_t(bytes[1] & 0x3F) << 12) |
+              (char32_t(bytes[2] & 0x3F) << 6) | (bytes[3] & 0x3F);
+   }
+ }
+
  // Helper function to lowercase and trim a string
  static std::string toLowerTrimmed(const std::string &s) {
    std::string result;
@@ -153,8 +185,7 @@
      return TextDecoderEncoding::UTF16BE;
    }
  
-   // Only supporting UTF-8 for now in this implementation
-   return std::nullopt;
+   return parseSingleByteLabel(trimmed);
  }
  
  // Get the canonical encoding name for the given encoding type.
@@ -168,6 +199,8 @@
        return "utf-16be";
      case TextDecoderEncoding::_count:
        break;
+     default:
+       return getSingleByteEncodingName(encoding);
    }
    return "utf-8"; // Default fallback
  }
@@ -314,6 +347,31 @@
    return i;
  }
  
+ // Transcode UTF-8 to UTF-16LE with U+FFFD replacement. Each ill-formed
+ // subsequence shrinks to a single code unit and every valid byte yields at
+ // most one, so the output never exceeds `length` units.
+ size_t convertUTF8ToUTF16WithReplacement(const uint8_t *bytes, size_t length,
+                                          char16_t *out) {
+   size_t i = 0;
+   size_t written = 0;
+   while (i < length) {
+     auto validation = simdutf::validate_utf8_with_errors(
+         reinterpret_cast<const char *>(bytes + i), length - i);
+     size_t validLen = validation.count;
+     if (validLen > 0) {
+       written += simdutf::convert_valid_utf8_to_utf16le(
+           reinterpret_cast<const char *>(bytes + i), validLen, out + written);
+       i += validLen;
+     }
+     if (validation.error == simdutf::error_code::SUCCESS) {
+       break;
+     }
+     out[written++] = static_cast<char16_t>(UNICODE_REPLACEMENT_CHARACTER);
+     i += maximalSubpartLength(bytes + i, length - i);
+   }
+   return written;
+ }
+
  // Decode UTF-8 bytes to a UTF-8 string (with validation and error handling).
  // Unlike Hermes which outputs UTF-16, we output UTF-8 since that's what
  // std::string uses and what our API returns.
@@ -345,14 +403,7 @@
    // sequences.
    size_t processLength = length;
    if (length > 0 && stream) {
-     // Find potential incomplete sequence at end (up to 3 bytes for 4-byte seq)
-     for (size_t tailLen = std::min(length, size_t(3)); tailLen > 0; --tailLen) {
-       size_t tailIndex = length - tailLen;
-       if (isValidPartialUTF8(bytes + tailIndex, tailLen)) {
-         processLength = tailIndex;
-         break;
-       }
-     }
+     processLength = length - incompleteUTF8TailLength(bytes, length);
    }
  
    // Only reserve if not already reserved by caller
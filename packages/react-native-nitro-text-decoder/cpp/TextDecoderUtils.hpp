@@ -20,7 +20,36 @@
    UTF8,
    UTF16LE,
    UTF16BE,
-   // Additional single-byte encodings could be added here
+   // Single-byte legacy encodings (see SingleByteDecoder.hpp); keep IBM866
+   // first and the order in sync with the tables there.
+   IBM866,
+   ISO_8859_2,
+   ISO_8859_3,
+   ISO_8859_4,
+   ISO_8859_5,
+   ISO_8859_6,
+   ISO_8859_7,
+   ISO_8859_8,
+   ISO_8859_8_I,
+   ISO_8859_10,
+   ISO_8859_13,
+   ISO_8859_14,
+   ISO_8859_15,
+   ISO_8859_16,
+   KOI8_R,
+   KOI8_U,
+   MACINTOSH,
+   WINDOWS_874,
+   WINDOWS_1250,
+   WINDOWS_1251,
+   WINDOWS_1252,
+   WINDOWS_1253,
+   WINDOWS_1254,
+   WINDOWS_1255,
+   WINDOWS_1256,
+   WINDOWS_1257,
+   WINDOWS_1258,
+   X_MAC_CYRILLIC,
    _count,
  };
  
@@ -33,6 +62,29 @@
  
  // Unicode replacement character U+FFFD
  static constexpr char32_t UNICODE_REPLACEMENT_CHARACTER = 0xFFFD;
+
+ // Non-ASCII UTF-8 chunks shorter than this go to the runtime's scalar
+ // transcoder (createFromUtf8); simdutf setup costs more than it saves below
+ // it. Tuned with the SmallScalar/SmallSimdutf runs in benchmarks/ (on x86-64
+ // simdutf draws level at ~32 bytes of non-ASCII text and is 2x ahead at 64).
+ static constexpr size_t kSimdMinBytes = 64;
+
+ // Largest per-thread scratch buffer kept between calls. One grown past this
+ // by a large call is freed on the way out, so a single big payload does not
+ // stay allocated for the JS thread's lifetime.
+ static constexpr size_t kScratchRetainBytes = 1 << 20;
+
+ // Scope guard applying kScratchRetainBytes to a std::vector or std::string.
+ template <typename Buffer>
+ struct ReleaseScratchIfLarge {
+   Buffer &buf;
+   ~ReleaseScratchIfLarge() {
+     if (buf.capacity() * sizeof(typename Buffer::value_type) >
+         kScratchRetainBytes) {
+       Buffer().swap(buf);
+     }
+   }
+ };
  
  // Parse the encoding label and return the corresponding encoding type.
  // Returns std::nullopt if the encoding is not supported.
@@ -54,6 +106,13 @@
  // Maximal subpart of an ill-formed subsequence.
  unsigned maximalSubpartLength(const uint8_t *bytes, size_t available);
 
+ // Length (0-3) of a trailing sequence that is a valid prefix of a longer
+ // code point, i.e. bytes a streaming decoder must carry into the next chunk.
+ size_t incompleteUTF8TailLength(const uint8_t *bytes, size_t length);
+
+ // Decode one well-formed UTF-8 sequence of `length` bytes (1-4).
+ char32_t decodeUTF8CodePoint(const uint8_t *bytes, size_t length);
+
  // Find the length of contiguous valid UTF-8 bytes (ASCII + multi-byte)
  // starting at ptr, up to maxLen. Stops at the first invalid byte.
  // Enables bulk-copy: decoded->append(ptr, validLen).
@@ -62,6 +121,13 @@
  // Length of contiguous ASCII (high-bit-clear) bytes starting at ptr.
  size_t findASCIIPrefixLength(const uint8_t *ptr, size_t maxLen);
 
+ // Transcode possibly ill-formed UTF-8 straight to UTF-16LE, emitting one
+ // U+FFFD per maximal subpart (WHATWG non-fatal semantics). Valid runs go
+ // through simdutf. `out` must hold at least `length` code units.
+ // Returns the number of code units written.
+ size_t convertUTF8ToUTF16WithReplacement(const uint8_t *bytes, size_t length,
+                                          char16_t *out);
+
  // Decode UTF-8 bytes to a UTF-8 string (with validation and error handling).
  // This differs from Hermes which outputs UTF-16 - we keep UTF-8 output
  // since that's what std::string uses.
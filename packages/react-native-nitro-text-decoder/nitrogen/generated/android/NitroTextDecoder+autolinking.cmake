@@ -34,7 +34,9 @@ target_sources(
   ../nitrogen/generated/android/NitroTextDecoderOnLoad.cpp
   # Shared Nitrogen C++ sources
   ../nitrogen/generated/shared/c++/HybridNitroTextDecoderSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroTextEncoderSpec.cpp
   ../nitrogen/generated/shared/c++/HybridNitroTextEncodingSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroJSONDocumentSpec.cpp
   # Android-specific Nitrogen C++ sources
   
 )
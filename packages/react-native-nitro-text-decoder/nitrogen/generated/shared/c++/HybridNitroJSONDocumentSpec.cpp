@@ -0,0 +1,21 @@
+///
+/// HybridNitroJSONDocumentSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroJSONDocumentSpec.hpp"
+
+namespace margelo::nitro::nitrotextdecoder {
+
+  void HybridNitroJSONDocumentSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("byteLength", &HybridNitroJSONDocumentSpec::getByteLength);
+    });
+  }
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -0,0 +1,60 @@
+///
+/// HybridNitroJSONDocumentSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+namespace margelo::nitro::nitrotextdecoder {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroJSONDocument`
+   * Inherit this class to create instances of `HybridNitroJSONDocumentSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroJSONDocument: public HybridNitroJSONDocumentSpec {
+   * public:
+   *   HybridNitroJSONDocument(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroJSONDocumentSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroJSONDocumentSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroJSONDocumentSpec() override = default;
+
+    public:
+      // Properties
+      virtual double getByteLength() = 0;
+
+    public:
+      // Methods
+      
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroJSONDocument";
+  };
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -18,6 +18,10 @@ namespace margelo::nitro::nitrotextdecoder {
       prototype.registerHybridGetter("fatal", &HybridNitroTextDecoderSpec::getFatal);
       prototype.registerHybridGetter("ignoreBOM", &HybridNitroTextDecoderSpec::getIgnoreBOM);
       prototype.registerHybridMethod("decode", &HybridNitroTextDecoderSpec::decode);
+      prototype.registerHybridMethod("decodeMany", &HybridNitroTextDecoderSpec::decodeMany);
+      prototype.registerHybridMethod("decodeManyJoined", &HybridNitroTextDecoderSpec::decodeManyJoined);
+      prototype.registerHybridMethod("getInternStats", &HybridNitroTextDecoderSpec::getInternStats);
+      prototype.registerHybridMethod("resetInternStats", &HybridNitroTextDecoderSpec::resetInternStats);
     });
   }
 
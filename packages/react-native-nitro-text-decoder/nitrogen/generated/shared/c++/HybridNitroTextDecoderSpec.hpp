@@ -15,11 +15,15 @@
 
 // Forward declaration of `TextDecodeOptions` to properly resolve imports.
 namespace margelo::nitro::nitrotextdecoder { struct TextDecodeOptions; }
+// Forward declaration of `InternStats` to properly resolve imports.
+namespace margelo::nitro::nitrotextdecoder { struct InternStats; }
 
 #include <string>
 #include <NitroModules/ArrayBuffer.hpp>
+#include <vector>
 #include <optional>
 #include "TextDecodeOptions.hpp"
+#include "InternStats.hpp"
 
 namespace margelo::nitro::nitrotextdecoder {
 
@@ -55,6 +59,10 @@ namespace margelo::nitro::nitrotextdecoder {
     public:
       // Methods
       virtual std::string decode(const std::optional<std::shared_ptr<ArrayBuffer>>& input, std::optional<double> byteOffset, std::optional<double> byteLength, const std::optional<TextDecodeOptions>& options) = 0;
+      virtual std::vector<std::string> decodeMany(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::optional<TextDecodeOptions>& options) = 0;
+      virtual std::string decodeManyJoined(const std::vector<std::shared_ptr<ArrayBuffer>>& inputs, const std::optional<TextDecodeOptions>& options) = 0;
+      virtual InternStats getInternStats() = 0;
+      virtual void resetInternStats() = 0;
 
     protected:
       // Hybrid Setup
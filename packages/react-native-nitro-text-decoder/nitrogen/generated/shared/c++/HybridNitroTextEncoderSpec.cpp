@@ -0,0 +1,26 @@
+///
+/// HybridNitroTextEncoderSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroTextEncoderSpec.hpp"
+
+namespace margelo::nitro::nitrotextdecoder {
+
+  void HybridNitroTextEncoderSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("encoding", &HybridNitroTextEncoderSpec::getEncoding);
+      prototype.registerHybridMethod("encode", &HybridNitroTextEncoderSpec::encode);
+      prototype.registerHybridMethod("encodeInto", &HybridNitroTextEncoderSpec::encodeInto);
+      prototype.registerHybridMethod("utf8Length", &HybridNitroTextEncoderSpec::utf8Length);
+      prototype.registerHybridMethod("base64Encode", &HybridNitroTextEncoderSpec::base64Encode);
+      prototype.registerHybridMethod("base64Decode", &HybridNitroTextEncoderSpec::base64Decode);
+    });
+  }
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -0,0 +1,70 @@
+///
+/// HybridNitroTextEncoderSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `TextEncoderEncodeIntoResult` to properly resolve imports.
+namespace margelo::nitro::nitrotextdecoder { struct TextEncoderEncodeIntoResult; }
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+#include "TextEncoderEncodeIntoResult.hpp"
+
+namespace margelo::nitro::nitrotextdecoder {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroTextEncoder`
+   * Inherit this class to create instances of `HybridNitroTextEncoderSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroTextEncoder: public HybridNitroTextEncoderSpec {
+   * public:
+   *   HybridNitroTextEncoder(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroTextEncoderSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroTextEncoderSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroTextEncoderSpec() override = default;
+
+    public:
+      // Properties
+      virtual std::string getEncoding() = 0;
+
+    public:
+      // Methods
+      virtual std::shared_ptr<ArrayBuffer> encode(const std::optional<std::string>& input) = 0;
+      virtual TextEncoderEncodeIntoResult encodeInto(const std::string& source, const std::shared_ptr<ArrayBuffer>& destination, std::optional<double> byteOffset, std::optional<double> byteLength) = 0;
+      virtual double utf8Length(const std::string& input) = 0;
+      virtual std::string base64Encode(const std::shared_ptr<ArrayBuffer>& input, std::optional<double> byteOffset, std::optional<double> byteLength, std::optional<bool> urlSafe) = 0;
+      virtual std::shared_ptr<ArrayBuffer> base64Decode(const std::string& input, std::optional<bool> urlSafe) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroTextEncoder";
+  };
+
+} // namespace margelo::nitro::nitrotextdecoder
@@ -15,6 +15,10 @@ namespace margelo::nitro::nitrotextdecoder {
     // load custom methods/properties
     registerHybrids(this, [](Prototype& prototype) {
       prototype.registerHybridMethod("createDecoder", &HybridNitroTextEncodingSpec::createDecoder);
+      prototype.registerHybridMethod("createEncoder", &HybridNitroTextEncodingSpec::createEncoder);
+      prototype.registerHybridMethod("decodeUTF8", &HybridNitroTextEncodingSpec::decodeUTF8);
+      prototype.registerHybridMethod("parseJSON", &HybridNitroTextEncodingSpec::parseJSON);
+      prototype.registerHybridMethod("setParallelDecodeOptions", &HybridNitroTextEncodingSpec::setParallelDecodeOptions);
     });
   }
 
@@ -17,12 +17,20 @@
 namespace margelo::nitro::nitrotextdecoder { class HybridNitroTextDecoderSpec; }
 // Forward declaration of `TextDecoderOptions` to properly resolve imports.
 namespace margelo::nitro::nitrotextdecoder { struct TextDecoderOptions; }
+// Forward declaration of `HybridNitroTextEncoderSpec` to properly resolve imports.
+namespace margelo::nitro::nitrotextdecoder { class HybridNitroTextEncoderSpec; }
+// Forward declaration of `HybridNitroJSONDocumentSpec` to properly resolve imports.
+namespace margelo::nitro::nitrotextdecoder { class HybridNitroJSONDocumentSpec; }
 
 #include <memory>
 #include "HybridNitroTextDecoderSpec.hpp"
 #include <string>
 #include <optional>
 #include "TextDecoderOptions.hpp"
+#include "HybridNitroTextEncoderSpec.hpp"
+#include "HybridNitroJSONDocumentSpec.hpp"
+#include <NitroModules/Promise.hpp>
+#include <NitroModules/ArrayBuffer.hpp>
 
 namespace margelo::nitro::nitrotextdecoder {
 
@@ -56,6 +64,10 @@ namespace margelo::nitro::nitrotextdecoder {
     public:
       // Methods
       virtual std::shared_ptr<HybridNitroTextDecoderSpec> createDecoder(const std::optional<std::string>& label, const std::optional<TextDecoderOptions>& options) = 0;
+      virtual std::shared_ptr<HybridNitroTextEncoderSpec> createEncoder() = 0;
+      virtual std::string decodeUTF8(const std::shared_ptr<ArrayBuffer>& input, std::optional<bool> fatal) = 0;
+      virtual std::shared_ptr<Promise<std::shared_ptr<HybridNitroJSONDocumentSpec>>> parseJSON(const std::shared_ptr<ArrayBuffer>& input, std::optional<double> byteOffset, std::optional<double> byteLength) = 0;
+      virtual void setParallelDecodeOptions(std::optional<double> minBytes, std::optional<double> workers) = 0;
 
     protected:
       // Hybrid Setup
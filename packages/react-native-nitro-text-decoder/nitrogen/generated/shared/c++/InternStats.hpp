@@ -0,0 +1,95 @@
+///
+/// InternStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrotextdecoder {
+
+  /**
+   * A struct which can be represented as a JavaScript object (InternStats).
+   */
+  struct InternStats final {
+  public:
+    double hits     SWIFT_PRIVATE;
+    double misses     SWIFT_PRIVATE;
+    double evictions     SWIFT_PRIVATE;
+    double entries     SWIFT_PRIVATE;
+
+  public:
+    InternStats() = default;
+    explicit InternStats(double hits, double misses, double evictions, double entries): hits(hits), misses(misses), evictions(evictions), entries(entries) {}
+
+  public:
+    friend bool operator==(const InternStats& lhs, const InternStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrotextdecoder
+
+namespace margelo::nitro {
+
+  // C++ InternStats <> JS InternStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrotextdecoder::InternStats> final {
+    static inline margelo::nitro::nitrotextdecoder::InternStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrotextdecoder::InternStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "hits"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "misses"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "evictions"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "entries")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrotextdecoder::InternStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "hits"), JSIConverter<double>::toJSI(runtime, arg.hits));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "misses"), JSIConverter<double>::toJSI(runtime, arg.misses));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "evictions"), JSIConverter<double>::toJSI(runtime, arg.evictions));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "entries"), JSIConverter<double>::toJSI(runtime, arg.entries));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "hits")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "misses")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "evictions")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "entries")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -41,10 +41,12 @@ namespace margelo::nitro::nitrotextdecoder {
   public:
     std::optional<bool> fatal     SWIFT_PRIVATE;
     std::optional<bool> ignoreBOM     SWIFT_PRIVATE;
+    std::optional<double> internMaxBytes     SWIFT_PRIVATE;
+    std::optional<double> internEntries     SWIFT_PRIVATE;
 
   public:
     TextDecoderOptions() = default;
-    explicit TextDecoderOptions(std::optional<bool> fatal, std::optional<bool> ignoreBOM): fatal(fatal), ignoreBOM(ignoreBOM) {}
+    explicit TextDecoderOptions(std::optional<bool> fatal, std::optional<bool> ignoreBOM, std::optional<double> internMaxBytes, std::optional<double> internEntries): fatal(fatal), ignoreBOM(ignoreBOM), internMaxBytes(internMaxBytes), internEntries(internEntries) {}
 
   public:
     friend bool operator==(const TextDecoderOptions& lhs, const TextDecoderOptions& rhs) = default;
@@ -61,13 +63,17 @@ namespace margelo::nitro {
       jsi::Object obj = arg.asObject(runtime);
       return margelo::nitro::nitrotextdecoder::TextDecoderOptions(
         JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fatal"))),
-        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "ignoreBOM")))
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "ignoreBOM"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "internMaxBytes"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "internEntries")))
       );
     }
     static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrotextdecoder::TextDecoderOptions& arg) {
       jsi::Object obj(runtime);
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "fatal"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.fatal));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "ignoreBOM"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.ignoreBOM));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "internMaxBytes"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.internMaxBytes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "internEntries"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.internEntries));
       return obj;
     }
     static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
@@ -80,6 +86,8 @@ namespace margelo::nitro {
       }
       if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fatal")))) return false;
       if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "ignoreBOM")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "internMaxBytes")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "internEntries")))) return false;
       return true;
     }
   };
@@ -0,0 +1,87 @@
+///
+/// TextEncoderEncodeIntoResult.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrotextdecoder {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TextEncoderEncodeIntoResult).
+   */
+  struct TextEncoderEncodeIntoResult final {
+  public:
+    double read     SWIFT_PRIVATE;
+    double written     SWIFT_PRIVATE;
+
+  public:
+    TextEncoderEncodeIntoResult() = default;
+    explicit TextEncoderEncodeIntoResult(double read, double written): read(read), written(written) {}
+
+  public:
+    friend bool operator==(const TextEncoderEncodeIntoResult& lhs, const TextEncoderEncodeIntoResult& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrotextdecoder
+
+namespace margelo::nitro {
+
+  // C++ TextEncoderEncodeIntoResult <> JS TextEncoderEncodeIntoResult (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrotextdecoder::TextEncoderEncodeIntoResult> final {
+    static inline margelo::nitro::nitrotextdecoder::TextEncoderEncodeIntoResult fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrotextdecoder::TextEncoderEncodeIntoResult(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "read"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "written")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrotextdecoder::TextEncoderEncodeIntoResult& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "read"), JSIConverter<double>::toJSI(runtime, arg.read));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "written"), JSIConverter<double>::toJSI(runtime, arg.written));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "read")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "written")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
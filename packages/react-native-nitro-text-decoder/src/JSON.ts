@@ -0,0 +1,49 @@
+import type { NitroJSONDocument } from './specs/TextDecoder.nitro'
+import { TextEncoding } from './TextEncoding'
+
+// materialize() and lazy() are raw JSI methods registered by
+// HybridJSONDocument::loadHybridMethods(). They return an arbitrary JSON
+// value, which a nitro spec cannot express, so they are typed here.
+interface JSONDocument extends NitroJSONDocument {
+  materialize(): any
+  lazy(): any
+}
+
+// JSON.parse over UTF-8 bytes without building the intermediate string on
+// the JS thread: native parses into a tape on a background thread, then
+// materializes the result in one pass.
+export async function parseJSON(
+  input: ArrayBuffer | ArrayBufferView
+): Promise<any> {
+  const document = await parseDocument(input)
+  return document.materialize()
+}
+
+// Like parseJSON, but objects and arrays come back as read-only proxies
+// over the native document: a member is only converted to a JS value when
+// it is read (and cached after that). Use it when a screen reads a few
+// fields out of a large payload. Arrays are array-like (`length` and
+// indices) rather than real arrays; use Array.from() to iterate them.
+export async function parseJSONLazy(
+  input: ArrayBuffer | ArrayBufferView
+): Promise<any> {
+  const document = await parseDocument(input)
+  return document.lazy()
+}
+
+async function parseDocument(
+  input: ArrayBuffer | ArrayBufferView
+): Promise<JSONDocument> {
+  try {
+    const document = ArrayBuffer.isView(input)
+      ? await TextEncoding.parseJSON(
+          input.buffer as ArrayBuffer,
+          input.byteOffset,
+          input.byteLength
+        )
+      : await TextEncoding.parseJSON(input)
+    return document as JSONDocument
+  } catch (e) {
+    throw new SyntaxError(e instanceof Error ? e.message : String(e))
+  }
+}
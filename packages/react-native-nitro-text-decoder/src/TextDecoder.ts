@@ -1,14 +1,36 @@
 import 'web-streams-polyfill/polyfill'
-import { NitroModules } from 'react-native-nitro-modules'
 import type {
+  InternStats,
   NitroTextDecoder,
-  NitroTextEncoding,
   TextDecodeOptions,
   TextDecoderOptions,
 } from './specs/TextDecoder.nitro'
+import { TextEncoding } from './TextEncoding'
 
-const TextEncoding =
-  NitroModules.createHybridObject<NitroTextEncoding>('NitroTextEncoding')
+export type DecodeInput = ArrayBuffer | ArrayBufferView
+
+export interface TextDecodeManyOptions extends TextDecodeOptions {
+  /** Return one concatenated string instead of one string per input. */
+  join?: boolean
+}
+
+function createNativeDecoder(
+  label: string,
+  options?: TextDecoderOptions
+): NitroTextDecoder {
+  if (label === null) {
+    throw new RangeError('Invalid encoding label')
+  }
+  if (options !== undefined && typeof options !== 'object') {
+    throw new TypeError('Options must be an object')
+  }
+
+  try {
+    return TextEncoding.createDecoder(label, options)
+  } catch (e: any) {
+    throw new RangeError(e.message)
+  }
+}
 
 export class TextDecoder {
   public readonly encoding: string
@@ -17,27 +39,13 @@ export class TextDecoder {
   private readonly decoder: NitroTextDecoder
 
   constructor(label: string = 'utf-8', options?: TextDecoderOptions) {
-    if (label === null) {
-      throw new RangeError('Invalid encoding label')
-    }
-    if (options !== undefined && typeof options !== 'object') {
-      throw new TypeError('Options must be an object')
-    }
-
-    try {
-      this.decoder = TextEncoding.createDecoder(label, options)
-    } catch (e: any) {
-      throw new RangeError(e.message)
-    }
+    this.decoder = createNativeDecoder(label, options)
     this.encoding = this.decoder.encoding
     this.fatal = this.decoder.fatal
     this.ignoreBOM = this.decoder.ignoreBOM
   }
 
-  decode(
-    input?: ArrayBuffer | ArrayBufferView,
-    options?: TextDecodeOptions
-  ): string {
+  decode(input?: DecodeInput, options?: TextDecodeOptions): string {
     if (options !== undefined && typeof options !== 'object') {
       throw new TypeError('Options must be an object')
     }
@@ -49,4 +57,118 @@ export class TextDecoder {
       throw new TypeError(e.message)
     }
   }
+
+  /**
+   * Decode a batch of buffers in one native call. Streaming state carries
+   * from one input to the next; only the last honours `options.stream`.
+   */
+  decodeMany(
+    inputs: DecodeInput[],
+    options: TextDecodeManyOptions & { join: true }
+  ): string
+  decodeMany(inputs: DecodeInput[], options?: TextDecodeManyOptions): string[]
+  decodeMany(
+    inputs: DecodeInput[],
+    options?: TextDecodeManyOptions
+  ): string | string[] {
+    if (!Array.isArray(inputs)) {
+      throw new TypeError('inputs must be an array')
+    }
+    if (options !== undefined && typeof options !== 'object') {
+      throw new TypeError('Options must be an object')
+    }
+    try {
+      const decoder = this.decoder as any
+      return options?.join
+        ? decoder.decodeManyJoined(inputs, options)
+        : decoder.decodeMany(inputs, options)
+    } catch (e: any) {
+      throw new TypeError(e.message)
+    }
+  }
+
+  /**
+   * Hit/miss counters of the intern cache enabled with the non-standard
+   * `internMaxBytes` / `internEntries` options (all zero when it is off).
+   * Use them to size the cache: a low hit rate with many evictions wants
+   * more entries.
+   */
+  getInternStats(): InternStats {
+    return this.decoder.getInternStats()
+  }
+
+  resetInternStats(): void {
+    this.decoder.resetInternStats()
+  }
+}
+
+const STREAM: TextDecodeOptions = { stream: true }
+
+/**
+ * WHATWG TextDecoderStream. Chunks go straight to the native decoder, which
+ * carries a sequence split across chunks in C++ until the next write.
+ */
+export class TextDecoderStream {
+  public readonly encoding: string
+  public readonly fatal: boolean
+  public readonly ignoreBOM: boolean
+  public readonly readable: ReadableStream<string>
+  public readonly writable: WritableStream<DecodeInput>
+
+  constructor(label: string = 'utf-8', options?: TextDecoderOptions) {
+    const decoder = createNativeDecoder(label, options) as any
+    this.encoding = decoder.encoding
+    this.fatal = decoder.fatal
+    this.ignoreBOM = decoder.ignoreBOM
+
+    const decode = (chunk?: DecodeInput): string => {
+      try {
+        return chunk === undefined
+          ? decoder.decode()
+          : decoder.decode(chunk, STREAM)
+      } catch (e: any) {
+        throw new TypeError(e.message)
+      }
+    }
+    const { readable, writable } = new TransformStream<DecodeInput, string>({
+      transform(chunk, controller) {
+        const text = decode(chunk)
+        if (text.length > 0) controller.enqueue(text)
+      },
+      flush(controller) {
+        const text = decode()
+        if (text.length > 0) controller.enqueue(text)
+      },
+    })
+    this.readable = readable
+    this.writable = writable
+  }
+}
+
+/**
+ * One-shot UTF-8 decode: `new TextDecoder('utf-8', { fatal }).decode(input)`
+ * without creating a decoder per call. No streaming state; a leading BOM is
+ * stripped.
+ */
+export function decodeUTF8(input?: DecodeInput, fatal: boolean = false): string {
+  try {
+    return (TextEncoding as any).decodeUTF8(input, fatal)
+  } catch (e: any) {
+    throw new TypeError(e.message)
+  }
+}
+
+export interface ParallelDecodeOptions {
+  /** UTF-8 inputs at least this large are decoded on several cores. */
+  minBytes?: number
+  /** Pool threads helping the JS thread; 0 disables the parallel path. */
+  workers?: number
+}
+
+/**
+ * Tune multi-core decoding of very large UTF-8 inputs (default: 1 MiB and
+ * up to 3 workers). Applies process-wide to every TextDecoder.
+ */
+export function configureParallelDecode(options: ParallelDecodeOptions): void {
+  TextEncoding.setParallelDecodeOptions(options.minBytes, options.workers)
 }
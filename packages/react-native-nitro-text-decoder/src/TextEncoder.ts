@@ -0,0 +1,71 @@
+import type {
+  NitroTextEncoder,
+  TextEncoderEncodeIntoResult,
+} from './specs/TextDecoder.nitro'
+import { TextEncoding } from './TextEncoding'
+
+// Stateless — one native encoder backs every TextEncoder instance.
+let _encoder: NitroTextEncoder | undefined
+function nativeEncoder(): NitroTextEncoder {
+  if (_encoder === undefined) {
+    _encoder = TextEncoding.createEncoder()
+  }
+  return _encoder
+}
+
+export class TextEncoder {
+  public readonly encoding: string = 'utf-8'
+
+  encode(input: string = ''): Uint8Array {
+    // Native transcodes the string in place (simdutf) into an exactly-sized
+    // ArrayBuffer.
+    return new Uint8Array(nativeEncoder().encode(input))
+  }
+
+  encodeInto(
+    source: string,
+    destination: Uint8Array
+  ): TextEncoderEncodeIntoResult {
+    if (!(destination instanceof Uint8Array)) {
+      throw new TypeError('Destination must be a Uint8Array')
+    }
+    // Native reads byteOffset/byteLength off the view directly.
+    return (nativeEncoder() as any).encodeInto(source, destination)
+  }
+}
+
+// UTF-8 byte length of `input` (lone surrogates count as U+FFFD), computed
+// without encoding. Handy for sizing buffers ahead of encodeInto().
+export function utf8Length(input: string): number {
+  return nativeEncoder().utf8Length(input)
+}
+
+export interface Base64Options {
+  // 'base64url' uses '-' and '_' and omits padding. Default 'base64'.
+  alphabet?: 'base64' | 'base64url'
+}
+
+// Vectorized (simdutf) base64 of the bytes, read in place from the buffer.
+export function base64Encode(
+  input: ArrayBuffer | ArrayBufferView,
+  options?: Base64Options
+): string {
+  return (nativeEncoder() as any).base64Encode(
+    input,
+    options?.alphabet === 'base64url'
+  )
+}
+
+// Decodes base64 (ASCII whitespace ignored, padding optional, like atob).
+// Throws on characters outside the alphabet.
+export function base64Decode(
+  input: string,
+  options?: Base64Options
+): Uint8Array {
+  return new Uint8Array(
+    (nativeEncoder() as any).base64Decode(
+      input,
+      options?.alphabet === 'base64url'
+    )
+  )
+}
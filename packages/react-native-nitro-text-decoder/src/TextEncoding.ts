@@ -0,0 +1,6 @@
+import { NitroModules } from 'react-native-nitro-modules'
+import type { NitroTextEncoding } from './specs/TextDecoder.nitro'
+
+// Single factory instance shared by TextDecoder and TextEncoder.
+export const TextEncoding =
+  NitroModules.createHybridObject<NitroTextEncoding>('NitroTextEncoding')
@@ -1,5 +1,38 @@
 // TODO: Export all HybridObjects here for the user
 
-import { TextDecoder } from './TextDecoder'
+import {
+  TextDecoder,
+  TextDecoderStream,
+  configureParallelDecode,
+  decodeUTF8,
+} from './TextDecoder'
+import {
+  TextEncoder,
+  utf8Length,
+  base64Encode,
+  base64Decode,
+} from './TextEncoder'
+import { parseJSON, parseJSONLazy } from './JSON'
 
-export { TextDecoder }
+export {
+  TextDecoder,
+  TextDecoderStream,
+  configureParallelDecode,
+  decodeUTF8,
+  TextEncoder,
+  utf8Length,
+  base64Encode,
+  base64Decode,
+  parseJSON,
+  parseJSONLazy,
+}
+export type { Base64Options } from './TextEncoder'
+export type {
+  InternStats,
+  TextDecoderOptions,
+} from './specs/TextDecoder.nitro'
+export type {
+  DecodeInput,
+  ParallelDecodeOptions,
+  TextDecodeManyOptions,
+} from './TextDecoder'
@@ -6,6 +6,16 @@ export interface TextDecodeOptions {
 export interface TextDecoderOptions {
   fatal?: boolean
   ignoreBOM?: boolean
+  /** Cache decoded strings of up to this many bytes (at most 256). */
+  internMaxBytes?: number
+  /** Cache slots, default 256, at most 4096. */
+  internEntries?: number
+}
+export interface InternStats {
+  hits: number
+  misses: number
+  evictions: number
+  entries: number
 }
 export interface NitroTextDecoder extends HybridObject<{
   ios: 'c++'
@@ -20,10 +30,53 @@ export interface NitroTextDecoder extends HybridObject<{
     byteLength?: number,
     options?: TextDecodeOptions
   ): string
+  decodeMany(inputs: ArrayBuffer[], options?: TextDecodeOptions): string[]
+  decodeManyJoined(inputs: ArrayBuffer[], options?: TextDecodeOptions): string
+  getInternStats(): InternStats
+  resetInternStats(): void
+}
+export interface TextEncoderEncodeIntoResult {
+  read: number
+  written: number
+}
+export interface NitroTextEncoder extends HybridObject<{
+  ios: 'c++'
+  android: 'c++'
+}> {
+  readonly encoding: string
+  encode(input?: string): ArrayBuffer
+  encodeInto(
+    source: string,
+    destination: ArrayBuffer,
+    byteOffset?: number,
+    byteLength?: number
+  ): TextEncoderEncodeIntoResult
+  utf8Length(input: string): number
+  base64Encode(
+    input: ArrayBuffer,
+    byteOffset?: number,
+    byteLength?: number,
+    urlSafe?: boolean
+  ): string
+  base64Decode(input: string, urlSafe?: boolean): ArrayBuffer
+}
+export interface NitroJSONDocument extends HybridObject<{
+  ios: 'c++'
+  android: 'c++'
+}> {
+  readonly byteLength: number
 }
 export interface NitroTextEncoding extends HybridObject<{
   ios: 'c++'
   android: 'c++'
 }> {
   createDecoder(label?: string, options?: TextDecoderOptions): NitroTextDecoder
+  createEncoder(): NitroTextEncoder
+  decodeUTF8(input: ArrayBuffer, fatal?: boolean): string
+  parseJSON(
+    input: ArrayBuffer,
+    byteOffset?: number,
+    byteLength?: number
+  ): Promise<NitroJSONDocument>
+  setParallelDecodeOptions(minBytes?: number, workers?: number): void
 }
@@ -7,44 +7,168 @@
 
 #include "LwsContext.hpp"
 #include "CaBundle.hpp"
+#include "TlsSessionCache.hpp"
 
 #include <libwebsockets.h>
+#include <pthread.h>
+#include <algorithm>
+#include <array>
+#include <ctime>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 
 namespace margelo::nitro::nitrofetchwebsockets {
 
+namespace {
 
-LwsContext& LwsContext::instance() {
-  static LwsContext inst;
-  return inst;
+const lws_protocols kProtocols[] = {
+  { "nitro-ws", nitroWsCallback, 0, 65536, 0, nullptr, 0 },
+  LWS_PROTOCOL_LIST_TERM
+};
+
+// Settings shared by the default vhost and the permessage-deflate ones.
+void fillClientInfo(lws_context_creation_info& info) {
+  info.port      = CONTEXT_PORT_NO_LISTEN;
+  info.protocols = kProtocols;
+  info.options   = LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
+  info.gid       = -1;
+  info.uid       = -1;
+
+#if defined(__ANDROID__) || defined(__APPLE__)
+  info.client_ssl_ca_mem     = kCacertPemData;
+  info.client_ssl_ca_mem_len = kCacertPemLen;
+#endif
+
+  // lws' per-vhost session cache; TlsSessionCache shares entries between
+  // vhosts and launches on top of it.
+  auto sessions = TlsSessionCache::instance().config();
+  info.tls_session_timeout   = static_cast<uint32_t>(sessions.maxAge.count());
+  info.tls_session_cache_max = static_cast<uint32_t>(sessions.maxEntries);
 }
 
+// Room for a burst of sends from JS before producers have to wait.
+constexpr size_t kQueueCapacity = 4096;
+
+// The shard whose service thread this is, if any.
+thread_local LwsContext* tServiceShard = nullptr;
+
+// lws timers are intrusive: the sul must stay alive until it fires. It is
+// the first member so the callback can recover the whole entry.
+struct DelayedOp {
+  lws_sorted_usec_list_t sul;
+  ServiceTask            op;
+};
+
+void runDelayedOp(lws_sorted_usec_list_t* sul) {
+  std::unique_ptr<DelayedOp> delayed(reinterpret_cast<DelayedOp*>(sul));
+  delayed->op();
+}
+
+} // namespace
 
-LwsContext::LwsContext() {
-  lws_set_log_level(LLL_ERR | LLL_WARN, nullptr);
 
-  static const lws_protocols protocols[] = {
-    { "nitro-ws", nitroWsCallback, 0, 65536, 0, nullptr, 0 },
-    LWS_PROTOCOL_LIST_TERM
+struct LwsContext::Registry {
+  struct Deleter {
+    void operator()(LwsContext* shard) const { delete shard; }
   };
 
-  lws_context_creation_info info = {};
-  info.port     = CONTEXT_PORT_NO_LISTEN;
-  info.protocols = protocols;
-  info.options  = LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
-  info.gid      = -1;
-  info.uid      = -1;
+  std::mutex mu;
+  size_t count = 1;
+  std::array<std::unique_ptr<LwsContext, Deleter>, kMaxShards> shards;
+
+  static Registry& get() {
+    static Registry registry;
+    return registry;
+  }
+
+  LwsContext& shardLocked(size_t index) {
+    auto& shard = shards[index];
+    if (!shard) shard.reset(new LwsContext(index));
+    return *shard;
+  }
+};
+
+
+LwsContext& LwsContext::instance() {
+  auto& registry = Registry::get();
+  std::lock_guard<std::mutex> lock(registry.mu);
+  return registry.shardLocked(0);
+}
+
+void LwsContext::setShardCount(size_t count) {
+  auto& registry = Registry::get();
+  std::lock_guard<std::mutex> lock(registry.mu);
+  registry.count = std::clamp<size_t>(count, 1, kMaxShards);
+}
+
+LwsContext& LwsContext::pinLeastLoaded() {
+  auto& registry = Registry::get();
+  std::lock_guard<std::mutex> lock(registry.mu);
+  // A shard that has not started yet counts as empty.
+  size_t best = 0;
+  size_t bestLoad = SIZE_MAX;
+  for (size_t i = 0; i < registry.count; ++i) {
+    auto& shard = registry.shards[i];
+    size_t load = shard ? shard->_connections.load(std::memory_order_relaxed) : 0;
+    if (load < bestLoad) {
+      best = i;
+      bestLoad = load;
+    }
+  }
+  LwsContext& shard = registry.shardLocked(best);
+  shard.pin();
+  return shard;
+}
+
+void LwsContext::pin() {
+  _connections.fetch_add(1, std::memory_order_relaxed);
+  _connectionsTotal.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LwsContext::unpin() {
+  _connections.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::vector<LwsContext::ShardStats> LwsContext::shardStats() {
+  auto& registry = Registry::get();
+  std::lock_guard<std::mutex> lock(registry.mu);
+  std::vector<ShardStats> out;
+  for (auto& shard : registry.shards) {
+    if (!shard) continue;
+    // Read from outside, so the service loop pays nothing for it.
+    double cpuMs = 0;
+    clockid_t clock;
+    timespec ts{};
+    if (pthread_getcpuclockid(shard->_serviceThread.native_handle(), &clock) == 0 &&
+        clock_gettime(clock, &ts) == 0) {
+      cpuMs = ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+    }
+    out.push_back(ShardStats{
+      shard->_index,
+      shard->_connections.load(std::memory_order_relaxed),
+      shard->_connectionsTotal.load(std::memory_order_relaxed),
+      cpuMs,
+      shard->_queue.stats(),
+    });
+  }
+  return out;
+}
 
-#if defined(__ANDROID__) || defined(__APPLE__)
-  info.client_ssl_ca_mem     = kCacertPemData;
-  info.client_ssl_ca_mem_len = kCacertPemLen;
-#endif
+
+LwsContext::LwsContext(size_t index)
+  : _index(index),
+    _queue(kQueueCapacity, [this]() { wakeup(); }) {
+  lws_set_log_level(LLL_ERR | LLL_WARN, nullptr);
+
+  lws_context_creation_info info = {};
+  fillClientInfo(info);
 
   _ctx = lws_create_context(&info);
   if (_ctx == nullptr) {
     throw std::runtime_error("Failed to create lws_context");
   }
+  _defaultVhost = lws_get_vhost_by_name(_ctx, "default");
 
   _serviceThread = std::thread([this]() { loop(); });
 }
@@ -60,32 +184,61 @@ LwsContext::~LwsContext() {
 
 
 
-void LwsContext::schedule(std::function<void()> op) {
-  {
-    std::lock_guard<std::mutex> lock(_mu);
-    _pending.push_back(std::move(op));
+void LwsContext::schedule(ServiceTask op) {
+  if (tServiceShard == this) {
+    // The ring's consumer must never wait on it.
+    _local.push_back(std::move(op));
+    return;
   }
-  wakeup();
+  _queue.push(std::move(op));
+}
+
+void LwsContext::scheduleAfter(std::chrono::microseconds delay, std::function<void()> op) {
+  auto* delayed = new DelayedOp{ {}, ServiceTask(std::move(op)) };
+  schedule([this, delayed, delay]() {
+    lws_sul_schedule(_ctx, 0, &delayed->sul, runDelayedOp, delay.count());
+  });
 }
 
 void LwsContext::wakeup() {
   lws_cancel_service(_ctx);
 }
 
+lws_vhost* LwsContext::deflateVhost(const std::string& deflateOffer) {
+  auto& entry = _deflateVhosts[deflateOffer];
+  if (entry) return entry->vhost;
+
+  entry = std::make_unique<DeflateVhost>();
+  entry->name  = "nitro-ws-pmd-" + std::to_string(_deflateVhosts.size());
+  entry->offer = deflateOffer;
+  entry->extensions[0] = { "permessage-deflate", nitroPmdCallback, entry->offer.c_str() };
+  entry->extensions[1] = { nullptr, nullptr, nullptr };
+
+  lws_context_creation_info info = {};
+  fillClientInfo(info);
+  info.vhost_name = entry->name.c_str();
+  info.extensions = entry->extensions;
+  entry->vhost = lws_create_vhost(_ctx, &info);
+  return entry->vhost;
+}
+
 
 void LwsContext::loop() {
+  tServiceShard = this;
+  pthread_setname_np(pthread_self(), ("nitro-ws-" + std::to_string(_index)).c_str());
+  std::vector<ServiceTask> ops;
   while (_running) {
-    // Drain pending operations before each service call. Scoped so the ops
-    // release their captured refs now, not after lws_service blocks.
-    {
-      std::vector<std::function<void()>> ops;
-      {
-        std::lock_guard<std::mutex> lock(_mu);
-        ops.swap(_pending);
-      }
-      for (auto& fn : ops) {
-        fn();
+    // Run pending operations before each service call. Each task is
+    // destroyed as soon as it has run, so captured refs are not held
+    // while lws_service blocks.
+    _queue.drain();
+    while (!_local.empty()) {
+      ops.swap(_local);
+      for (auto& op : ops) {
+        op();
+        op.reset();
       }
+      ops.clear();
     }
 
     lws_service(_ctx, 50);
@@ -7,12 +7,17 @@
 
 #pragma once
 
+#include "ServiceQueue.hpp"
+
 #include <libwebsockets.h>
+#include <chrono>
 #include <thread>
 #include <atomic>
-#include <mutex>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace margelo::nitro::nitrofetchwebsockets {
 
@@ -20,26 +25,84 @@ namespace margelo::nitro::nitrofetchwebsockets {
 int nitroWsCallback(lws* wsi, enum lws_callback_reasons reason,
                     void* user, void* in, size_t len);
 
+// permessage-deflate extension: lws' own implementation plus per-connection
+// bookkeeping (minimum message size, compression stats).
+int nitroPmdCallback(lws_context* context, const lws_extension* ext, lws* wsi,
+                     enum lws_extension_callback_reasons reason,
+                     void* user, void* in, size_t len);
+
 } // namespace margelo::nitro::nitrofetchwebsockets
 
 
 namespace margelo::nitro::nitrofetchwebsockets {
 
 
+// One lws_context with its own service thread. There can be several
+// (shards) so that a busy socket's TLS, inflate and callback work does not
+// delay the others; each connection is pinned to one shard for its
+// lifetime.
 class LwsContext {
 public:
+  static constexpr size_t kMaxShards = 8;
+
+  // Shard 0, started on first use.
   static LwsContext& instance();
 
+  // How many shards new connections are spread over (clamped to
+  // 1...kMaxShards, default 1). Shards are started on demand; lowering the
+  // count leaves existing connections where they are.
+  static void setShardCount(size_t count);
+
+  // Pins a new connection to the shard with the fewest pinned connections
+  // (lowest index on a tie). The pick and the count happen under one lock,
+  // so a burst of connections created together spreads over the shards.
+  static LwsContext& pinLeastLoaded();
+
+  // Load accounting for a connection already on this shard: pin() when it
+  // connects again after unpin(), unpin() once lws is done with it or it
+  // is destroyed. Any thread.
+  void pin();
+  void unpin();
+
+  struct ShardStats {
+    size_t   index;
+    size_t   connections;       // pinned now
+    uint64_t connectionsTotal;  // ever pinned
+    double   cpuTimeMs;         // service thread CPU time
+    ServiceQueue::Stats queue;
+  };
+  // Started shards only.
+  static std::vector<ShardStats> shardStats();
+
   lws_context* ctx() const { return _ctx; }
 
+  // The vhost lws_create_context() made, used by connects without extensions.
+  lws_vhost* defaultVhost() const { return _defaultVhost; }
 
-  void schedule(std::function<void()> op);
 
+  // Runs `op` on the service thread. From other threads this goes through
+  // the lock-free ServiceQueue; from the service thread itself (lws
+  // callbacks) it is appended to a local list run after lws_service().
+  void schedule(ServiceTask op);
+
+  // Runs `op` on the service thread once `delay` has passed (lws_sul timer).
+  void scheduleAfter(std::chrono::microseconds delay, std::function<void()> op);
 
   void wakeup();
 
+  ServiceQueue::Stats queueStats() const { return _queue.stats(); }
+
+  // Client vhost that offers `deflateOffer` (a Sec-WebSocket-Extensions
+  // value) on every connection made through it. lws only configures
+  // extensions per vhost, so there is one per distinct offer, created on
+  // first use and kept until the context goes away. Returns nullptr if lws
+  // could not create it. Service thread only.
+  lws_vhost* deflateVhost(const std::string& deflateOffer);
+
 private:
-  LwsContext();
+  struct Registry;
+
+  explicit LwsContext(size_t index);
   ~LwsContext();
 
   // Non-copyable / non-movable singleton
@@ -48,11 +111,23 @@ private:
 
   void loop();
 
+  const size_t _index;
   lws_context* _ctx = nullptr;
+  lws_vhost*   _defaultVhost = nullptr;
+  std::atomic<size_t>   _connections{0};
+  std::atomic<uint64_t> _connectionsTotal{0};
   std::thread _serviceThread;
   std::atomic<bool> _running{true};
-  std::mutex _mu;
-  std::vector<std::function<void()>> _pending;
+  ServiceQueue _queue;
+  std::vector<ServiceTask> _local;  // service thread only
+
+  struct DeflateVhost {
+    std::string   name;
+    std::string   offer;
+    lws_extension extensions[2];
+    lws_vhost*    vhost = nullptr;
+  };
+  std::unordered_map<std::string, std::unique_ptr<DeflateVhost>> _deflateVhosts;
 };
 
 } // namespace margelo::nitro::nitrofetchwebsockets
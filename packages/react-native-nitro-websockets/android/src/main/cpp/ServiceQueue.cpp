@@ -0,0 +1,131 @@
+/*
+ * ServiceQueue implementation. See ServiceQueue.hpp.
+ */
+
+#include "ServiceQueue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+namespace {
+
+template <typename T>
+void raiseTo(std::atomic<T>& max, T value) {
+  T cur = max.load(std::memory_order_relaxed);
+  while (value > cur && !max.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+}
+
+} // namespace
+
+
+ServiceQueue::ServiceQueue(size_t capacity, std::function<void()> wake)
+  : _mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+    _slots(new Slot[_mask + 1]),
+    _wake(std::move(wake)) {
+  for (size_t i = 0; i <= _mask; ++i) {
+    _slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+}
+
+ServiceQueue::~ServiceQueue() = default;
+
+bool ServiceQueue::tryPush(ServiceTask& task) {
+  size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;) {
+    slot = &_slots[pos & _mask];
+    size_t seq = slot->seq.load(std::memory_order_acquire);
+    auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (diff < 0) {
+      return false;  // the consumer has not freed this slot yet
+    } else {
+      pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->pushedAt = Clock::now();
+  slot->task = std::move(task);
+  slot->seq.store(pos + 1, std::memory_order_release);
+
+  size_t deq = _dequeuePos.load(std::memory_order_relaxed);
+  if (pos + 1 > deq) raiseTo(_maxDepth, pos + 1 - deq);
+  return true;
+}
+
+void ServiceQueue::push(ServiceTask&& task) {
+  _scheduled.fetch_add(1, std::memory_order_relaxed);
+  if (task.onHeap()) _heapTasks.fetch_add(1, std::memory_order_relaxed);
+
+  if (!tryPush(task)) [[unlikely]] {
+    _fullWaits.fetch_add(1, std::memory_order_relaxed);
+    size_t spins = 0;
+    do {
+      if (spins++ % 64 == 0) wakeConsumer();
+      std::this_thread::yield();
+    } while (!tryPush(task));
+  }
+
+  // Pairs with the exchange in drain(): either this push is visible to the
+  // drain that cleared the flag, or this producer sees it cleared and wakes.
+  if (!_wakePending.exchange(true, std::memory_order_acq_rel)) {
+    _wakeups.fetch_add(1, std::memory_order_relaxed);
+    _wake();
+  }
+}
+
+void ServiceQueue::wakeConsumer() {
+  _wakePending.store(true, std::memory_order_release);
+  _wake();
+}
+
+void ServiceQueue::drain() {
+  _wakePending.exchange(false, std::memory_order_acq_rel);
+
+  // Bounded so producers that keep pushing cannot starve lws_service().
+  size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+  for (size_t n = 0; n <= _mask; ++n) {
+    Slot& slot = _slots[pos & _mask];
+    if (slot.seq.load(std::memory_order_acquire) != pos + 1) return;
+
+    ServiceTask task = std::move(slot.task);
+    auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - slot.pushedAt).count();
+    slot.seq.store(pos + _mask + 1, std::memory_order_release);
+    _dequeuePos.store(++pos, std::memory_order_relaxed);
+
+    _executed.fetch_add(1, std::memory_order_relaxed);
+    _totalLatencyNs.fetch_add(static_cast<uint64_t>(latency), std::memory_order_relaxed);
+    raiseTo(_maxLatencyNs, static_cast<uint64_t>(latency));
+
+    task();
+  }
+  // Stopped at the bound with work left: come straight back.
+  if (_slots[pos & _mask].seq.load(std::memory_order_acquire) == pos + 1) {
+    wakeConsumer();
+  }
+}
+
+ServiceQueue::Stats ServiceQueue::stats() const {
+  Stats s;
+  s.scheduled = _scheduled.load(std::memory_order_relaxed);
+  s.wakeups   = _wakeups.load(std::memory_order_relaxed);
+  s.heapTasks = _heapTasks.load(std::memory_order_relaxed);
+  s.fullWaits = _fullWaits.load(std::memory_order_relaxed);
+  size_t enq  = _enqueuePos.load(std::memory_order_relaxed);
+  size_t deq  = _dequeuePos.load(std::memory_order_relaxed);
+  s.depth     = enq > deq ? enq - deq : 0;
+  s.maxDepth  = _maxDepth.load(std::memory_order_relaxed);
+  uint64_t executed = _executed.load(std::memory_order_relaxed);
+  if (executed > 0) {
+    s.meanLatencyUs = _totalLatencyNs.load(std::memory_order_relaxed) / 1000.0 / executed;
+  }
+  s.maxLatencyUs = _maxLatencyNs.load(std::memory_order_relaxed) / 1000.0;
+  return s;
+}
+
+} // namespace margelo::nitro::nitrofetchwebsockets
@@ -0,0 +1,175 @@
+/*
+ * Hand-off of work from JS / app threads to the lws service thread.
+ *
+ * send(), close() and the callback setters each post a small closure. A
+ * mutex-guarded vector of std::function meant a heap allocation, a lock
+ * shared with the service thread and a lws_cancel_service() syscall per
+ * call. ServiceQueue is a bounded lock-free multi-producer / single-consumer
+ * ring (Vyukov's per-slot sequence scheme) of ServiceTasks, which store
+ * closures of up to kInlineSize bytes in place. Only the producer that
+ * finds no wakeup pending pays for one; the rest ride along.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+
+// Move-only void() closure with small-buffer storage. Larger closures (a
+// connect carrying the URL parts and headers) fall back to the heap.
+class ServiceTask {
+public:
+  static constexpr size_t kInlineSize = 48;
+
+  ServiceTask() = default;
+
+  template <typename F,
+            typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, ServiceTask>>>
+  ServiceTask(F&& fn) {  // NOLINT: implicit, so schedule() takes lambdas as-is
+    using Fn = std::decay_t<F>;
+    if constexpr (sizeof(Fn) <= kInlineSize &&
+                  alignof(Fn) <= alignof(std::max_align_t) &&
+                  std::is_nothrow_move_constructible_v<Fn>) {
+      ::new (static_cast<void*>(_storage)) Fn(std::forward<F>(fn));
+      _ops = &kInlineOps<Fn>;
+    } else {
+      ::new (static_cast<void*>(_storage)) Fn*(new Fn(std::forward<F>(fn)));
+      _ops = &kHeapOps<Fn>;
+    }
+  }
+
+  ServiceTask(ServiceTask&& other) noexcept { moveFrom(other); }
+  ServiceTask& operator=(ServiceTask&& other) noexcept {
+    if (this != &other) {
+      reset();
+      moveFrom(other);
+    }
+    return *this;
+  }
+  ServiceTask(const ServiceTask&) = delete;
+  ServiceTask& operator=(const ServiceTask&) = delete;
+  ~ServiceTask() { reset(); }
+
+  explicit operator bool() const { return _ops != nullptr; }
+  bool onHeap() const { return _ops && !_ops->inlined; }
+
+  void operator()() { _ops->invoke(_storage); }
+
+  void reset() noexcept {
+    if (_ops) {
+      _ops->destroy(_storage);
+      _ops = nullptr;
+    }
+  }
+
+private:
+  struct Ops {
+    void (*invoke)(void* storage);
+    void (*move)(void* from, void* to) noexcept;
+    void (*destroy)(void* storage) noexcept;
+    bool inlined;
+  };
+
+  template <typename Fn>
+  static constexpr Ops kInlineOps = {
+    [](void* s) { (*static_cast<Fn*>(s))(); },
+    [](void* from, void* to) noexcept {
+      ::new (to) Fn(std::move(*static_cast<Fn*>(from)));
+      static_cast<Fn*>(from)->~Fn();
+    },
+    [](void* s) noexcept { static_cast<Fn*>(s)->~Fn(); },
+    true,
+  };
+
+  template <typename Fn>
+  static constexpr Ops kHeapOps = {
+    [](void* s) { (**static_cast<Fn**>(s))(); },
+    [](void* from, void* to) noexcept { ::new (to) Fn*(*static_cast<Fn**>(from)); },
+    [](void* s) noexcept { delete *static_cast<Fn**>(s); },
+    false,
+  };
+
+  void moveFrom(ServiceTask& other) noexcept {
+    if (other._ops) {
+      other._ops->move(other._storage, _storage);
+      _ops = std::exchange(other._ops, nullptr);
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char _storage[kInlineSize];
+  const Ops* _ops = nullptr;
+};
+
+
+class ServiceQueue {
+public:
+  struct Stats {
+    uint64_t scheduled = 0;     // tasks pushed
+    uint64_t wakeups = 0;       // times the consumer actually had to be woken
+    uint64_t heapTasks = 0;     // tasks too large for inline storage
+    uint64_t fullWaits = 0;     // pushes that found the ring full and waited
+    size_t   depth = 0;         // tasks queued right now
+    size_t   maxDepth = 0;
+    double   meanLatencyUs = 0; // push to start of execution
+    double   maxLatencyUs = 0;
+  };
+
+  // `capacity` is rounded up to a power of two. `wake` interrupts the
+  // consumer's wait; it is called at most once per drain().
+  ServiceQueue(size_t capacity, std::function<void()> wake);
+  ~ServiceQueue();
+
+  ServiceQueue(const ServiceQueue&) = delete;
+  ServiceQueue& operator=(const ServiceQueue&) = delete;
+
+  // Any thread except the consumer's. Yields while the ring is full.
+  void push(ServiceTask&& task);
+
+  // Consumer thread only: runs the tasks queued so far, in push order per
+  // producer.
+  void drain();
+
+  Stats stats() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Slot {
+    std::atomic<size_t> seq;
+    Clock::time_point   pushedAt;
+    ServiceTask         task;
+  };
+
+  bool tryPush(ServiceTask& task);
+  void wakeConsumer();
+
+  const size_t _mask;
+  std::unique_ptr<Slot[]> _slots;
+  std::function<void()> _wake;
+
+  alignas(64) std::atomic<size_t> _enqueuePos{0};
+  alignas(64) std::atomic<size_t> _dequeuePos{0};
+  std::atomic<bool> _wakePending{false};
+
+  std::atomic<uint64_t> _scheduled{0};
+  std::atomic<uint64_t> _wakeups{0};
+  std::atomic<uint64_t> _heapTasks{0};
+  std::atomic<uint64_t> _fullWaits{0};
+  std::atomic<size_t>   _maxDepth{0};
+  // Written by the consumer only.
+  std::atomic<uint64_t> _executed{0};
+  std::atomic<uint64_t> _totalLatencyNs{0};
+  std::atomic<uint64_t> _maxLatencyNs{0};
+};
+
+} // namespace margelo::nitro::nitrofetchwebsockets
@@ -0,0 +1,328 @@
+/*
+ * TlsSessionCache implementation. See TlsSessionCache.hpp.
+ *
+ * File layout: "NWTS", a version byte (both authenticated as AAD), a
+ * 12-byte IV, the 16-byte GCM tag, then the encrypted entries:
+ * u32 count, and per entry u16 key length, key, i64 storedAt,
+ * u32 blob length, blob. Native byte order; the file never leaves the
+ * device.
+ */
+
+#include "TlsSessionCache.hpp"
+#include "LwsContext.hpp"
+
+#include <mbedtls/gcm.h>
+#include <mbedtls/platform_util.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+namespace {
+
+constexpr uint8_t kMagic[] = { 'N', 'W', 'T', 'S', 1 };
+constexpr size_t  kIvSize  = 12;
+constexpr size_t  kTagSize = 16;
+constexpr size_t  kKeySize = 32;
+
+// Several handshakes finishing together cost one write.
+constexpr std::chrono::microseconds kFlushDelay{1000000};
+
+// lws hands over the serialized session here; it frees the buffer itself.
+int saveSession(lws_context*, lws_tls_session_dump* info) {
+  auto* out = static_cast<std::vector<uint8_t>*>(info->opaque);
+  const auto* blob = static_cast<const uint8_t*>(info->blob);
+  out->assign(blob, blob + info->blob_len);
+  return 0;
+}
+
+// lws takes ownership of a malloc()ed copy and frees it after import.
+int loadSession(lws_context*, lws_tls_session_dump* info) {
+  const auto* in = static_cast<const std::vector<uint8_t>*>(info->opaque);
+  void* blob = malloc(in->size());
+  if (blob == nullptr) return 1;
+  memcpy(blob, in->data(), in->size());
+  info->blob     = blob;
+  info->blob_len = in->size();
+  return 0;
+}
+
+template <typename T>
+void put(std::vector<uint8_t>& out, T value) {
+  const auto* p = reinterpret_cast<const uint8_t*>(&value);
+  out.insert(out.end(), p, p + sizeof(T));
+}
+
+struct Reader {
+  const uint8_t* p;
+  const uint8_t* end;
+
+  template <typename T>
+  bool get(T& value) {
+    if (static_cast<size_t>(end - p) < sizeof(T)) return false;
+    memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+  }
+
+  bool bytes(size_t n, const uint8_t*& out) {
+    if (static_cast<size_t>(end - p) < n) return false;
+    out = p;
+    p += n;
+    return true;
+  }
+};
+
+bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (f == nullptr) return false;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+// Written beside the target and renamed over it, so a crash mid-write
+// leaves the previous file intact.
+bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+  std::string tmp = path + ".tmp";
+  FILE* f = fopen(tmp.c_str(), "wb");
+  if (f == nullptr) return false;
+  bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+  ok = fclose(f) == 0 && ok;
+  if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+    remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+std::vector<uint8_t> seal(const std::vector<uint8_t>& key, const std::vector<uint8_t>& plain) {
+  std::vector<uint8_t> out(kMagic, kMagic + sizeof(kMagic));
+  out.resize(sizeof(kMagic) + kIvSize + kTagSize + plain.size());
+  uint8_t* iv  = out.data() + sizeof(kMagic);
+  uint8_t* tag = iv + kIvSize;
+  arc4random_buf(iv, kIvSize);
+
+  mbedtls_gcm_context gcm;
+  mbedtls_gcm_init(&gcm);
+  int rc = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key.data(), kKeySize * 8);
+  if (rc == 0) {
+    rc = mbedtls_gcm_crypt_and_tag(&gcm, MBEDTLS_GCM_ENCRYPT, plain.size(),
+                                   iv, kIvSize, kMagic, sizeof(kMagic),
+                                   plain.data(), tag + kTagSize, kTagSize, tag);
+  }
+  mbedtls_gcm_free(&gcm);
+  if (rc != 0) out.clear();
+  return out;
+}
+
+bool unseal(const std::vector<uint8_t>& key, const std::vector<uint8_t>& sealed,
+            std::vector<uint8_t>& plain) {
+  size_t header = sizeof(kMagic) + kIvSize + kTagSize;
+  if (sealed.size() < header || memcmp(sealed.data(), kMagic, sizeof(kMagic)) != 0) return false;
+  const uint8_t* iv  = sealed.data() + sizeof(kMagic);
+  const uint8_t* tag = iv + kIvSize;
+  plain.resize(sealed.size() - header);
+
+  mbedtls_gcm_context gcm;
+  mbedtls_gcm_init(&gcm);
+  int rc = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, key.data(), kKeySize * 8);
+  if (rc == 0) {
+    rc = mbedtls_gcm_auth_decrypt(&gcm, plain.size(), iv, kIvSize, kMagic, sizeof(kMagic),
+                                  tag, kTagSize, tag + kTagSize, plain.data());
+  }
+  mbedtls_gcm_free(&gcm);
+  return rc == 0;
+}
+
+} // namespace
+
+
+TlsSessionCache& TlsSessionCache::instance() {
+  static TlsSessionCache cache;
+  return cache;
+}
+
+std::string TlsSessionCache::keyFor(const std::string& host, int port) {
+  return host + ":" + std::to_string(port);
+}
+
+int64_t TlsSessionCache::now() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+      SystemClock::now().time_since_epoch()).count();
+}
+
+void TlsSessionCache::configure(const Config& config) {
+  std::lock_guard<std::mutex> lock(_mu);
+  _config = config;
+  trimLocked();
+}
+
+TlsSessionCache::Config TlsSessionCache::config() {
+  std::lock_guard<std::mutex> lock(_mu);
+  return _config;
+}
+
+bool TlsSessionCache::enablePersistence(const std::string& path, const std::vector<uint8_t>& key) {
+  if (key.size() != kKeySize || path.empty()) return false;
+
+  // A file from a different key (app data restored elsewhere, key lost)
+  // does not decrypt and is simply overwritten by the next write.
+  std::vector<uint8_t> sealed, plain;
+  if (readFile(path, sealed) && unseal(key, sealed, plain)) deserialize(plain);
+  mbedtls_platform_zeroize(plain.data(), plain.size());
+
+  std::lock_guard<std::mutex> lock(_mu);
+  _path = path;
+  _key  = key;
+  return true;
+}
+
+void TlsSessionCache::clear() {
+  std::string path;
+  {
+    std::lock_guard<std::mutex> lock(_mu);
+    _entries.clear();
+    path = _path;
+  }
+  if (!path.empty()) remove(path.c_str());
+}
+
+void TlsSessionCache::offer(lws_vhost* vhost, const std::string& host, int port) {
+  std::vector<uint8_t> blob;
+  {
+    std::lock_guard<std::mutex> lock(_mu);
+    auto it = _entries.find(keyFor(host, port));
+    if (it == _entries.end()) return;
+    if (now() - it->second.storedAt > _config.maxAge.count()) {
+      _entries.erase(it);
+      return;
+    }
+    blob = it->second.blob;
+  }
+  if (lws_tls_session_dump_load(vhost, host.c_str(), static_cast<uint16_t>(port),
+                                loadSession, &blob) == 0) {
+    _offered.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void TlsSessionCache::recordHandshake(lws* wsi) {
+  if (lws_tls_session_is_reused(wsi)) {
+    _resumedHandshakes.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    _fullHandshakes.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void TlsSessionCache::capture(LwsContext& shard, lws_vhost* vhost,
+                              const std::string& host, int port) {
+  std::vector<uint8_t> blob;
+  if (lws_tls_session_dump_save(vhost, host.c_str(), static_cast<uint16_t>(port),
+                                saveSession, &blob) != 0 || blob.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mu);
+    auto& entry = _entries[keyFor(host, port)];
+    if (entry.blob == blob) return;
+    entry.blob     = std::move(blob);
+    entry.storedAt = now();
+    trimLocked();
+    if (_path.empty() || _flushPending) return;
+    _flushPending = true;
+  }
+  shard.scheduleAfter(kFlushDelay, [this]() { flush(); });
+}
+
+TlsSessionCache::Stats TlsSessionCache::stats() {
+  Stats s;
+  s.fullHandshakes    = _fullHandshakes.load(std::memory_order_relaxed);
+  s.resumedHandshakes = _resumedHandshakes.load(std::memory_order_relaxed);
+  s.offered           = _offered.load(std::memory_order_relaxed);
+  s.restored          = _restored.load(std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(_mu);
+  s.cached     = _entries.size();
+  s.persistent = !_path.empty();
+  return s;
+}
+
+void TlsSessionCache::trimLocked() {
+  while (_entries.size() > _config.maxEntries) {
+    auto oldest = std::min_element(_entries.begin(), _entries.end(), [](const auto& a, const auto& b) {
+      return a.second.storedAt < b.second.storedAt;
+    });
+    _entries.erase(oldest);
+  }
+}
+
+// Runs on a service thread. The file is a few KB and sits in app-private
+// storage, so it is written inline rather than on a thread of its own.
+void TlsSessionCache::flush() {
+  std::string path;
+  std::vector<uint8_t> key, plain;
+  {
+    std::lock_guard<std::mutex> lock(_mu);
+    _flushPending = false;
+    if (_path.empty()) return;
+    path  = _path;
+    key   = _key;
+    plain = serializeLocked();
+  }
+  auto sealed = seal(key, plain);
+  mbedtls_platform_zeroize(plain.data(), plain.size());
+  mbedtls_platform_zeroize(key.data(), key.size());
+  if (!sealed.empty()) writeFile(path, sealed);
+}
+
+std::vector<uint8_t> TlsSessionCache::serializeLocked() const {
+  int64_t cutoff = now() - _config.maxAge.count();
+  std::vector<uint8_t> out;
+  put<uint32_t>(out, 0);
+  uint32_t count = 0;
+  for (const auto& [key, entry] : _entries) {
+    if (entry.storedAt < cutoff) continue;
+    put<uint16_t>(out, static_cast<uint16_t>(key.size()));
+    out.insert(out.end(), key.begin(), key.end());
+    put<int64_t>(out, entry.storedAt);
+    put<uint32_t>(out, static_cast<uint32_t>(entry.blob.size()));
+    out.insert(out.end(), entry.blob.begin(), entry.blob.end());
+    count++;
+  }
+  memcpy(out.data(), &count, sizeof(count));
+  return out;
+}
+
+void TlsSessionCache::deserialize(const std::vector<uint8_t>& data) {
+  Reader r{ data.data(), data.data() + data.size() };
+  uint32_t count = 0;
+  if (!r.get(count)) return;
+
+  std::lock_guard<std::mutex> lock(_mu);
+  int64_t cutoff = now() - _config.maxAge.count();
+  for (uint32_t i = 0; i < count; ++i) {
+    uint16_t keyLen;
+    int64_t storedAt;
+    uint32_t blobLen;
+    const uint8_t* key;
+    const uint8_t* blob;
+    if (!r.get(keyLen) || !r.bytes(keyLen, key) || !r.get(storedAt) ||
+        !r.get(blobLen) || !r.bytes(blobLen, blob)) {
+      return;
+    }
+    if (storedAt < cutoff) continue;
+    // A session stored this run is newer than anything on disk.
+    auto [it, inserted] = _entries.try_emplace(std::string(reinterpret_cast<const char*>(key), keyLen));
+    if (!inserted) continue;
+    it->second.blob.assign(blob, blob + blobLen);
+    it->second.storedAt = storedAt;
+    _restored.fetch_add(1, std::memory_order_relaxed);
+  }
+  trimLocked();
+}
+
+} // namespace margelo::nitro::nitrofetchwebsockets
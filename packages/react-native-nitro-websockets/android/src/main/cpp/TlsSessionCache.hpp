@@ -0,0 +1,106 @@
+/*
+ * TLS session resumption across connections, service threads and launches.
+ *
+ * lws keeps client sessions (ticket or session ID) in memory per vhost,
+ * tagged vhost + host + port. A session learned on one shard or deflate
+ * vhost is therefore never offered by another, and none survive a restart.
+ * TlsSessionCache keeps one serialized session per host:port, as produced
+ * by lws_tls_session_dump_save(), and loads it into the vhost a wss connect
+ * is about to use. With persistence on, the entries are also written to an
+ * AES-256-GCM encrypted file so the first connection after a cold start can
+ * resume.
+ */
+
+#pragma once
+
+#include <libwebsockets.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+
+class LwsContext;
+
+class TlsSessionCache {
+public:
+  struct Config {
+    size_t maxEntries = 32;                // oldest dropped first
+    std::chrono::seconds maxAge{86400};    // older sessions are not offered
+  };
+
+  struct Stats {
+    uint64_t fullHandshakes = 0;
+    uint64_t resumedHandshakes = 0;
+    uint64_t offered = 0;    // stored sessions loaded into lws before a connect
+    uint64_t restored = 0;   // entries read from the file at startup
+    size_t   cached = 0;
+    bool     persistent = false;
+  };
+
+  static TlsSessionCache& instance();
+
+  // Also sizes the in-memory lws caches of vhosts created afterwards.
+  void configure(const Config& config);
+  Config config();
+
+  // Reads what an earlier run left in `path` and writes changes back to it.
+  // `key` is the 32-byte AES key; the Kotlin side keeps it wrapped by the
+  // Android Keystore. Returns false if the key has the wrong size.
+  bool enablePersistence(const std::string& path, const std::vector<uint8_t>& key);
+
+  // Forgets every stored session and deletes the file. lws' own in-memory
+  // copies are not reachable from here: they age out after maxAge, and a
+  // connection that is still open can store its session again.
+  void clear();
+
+  // Service thread, right before a wss connect through `vhost`.
+  void offer(lws_vhost* vhost, const std::string& host, int port);
+
+  // Service thread, at LWS_CALLBACK_CLIENT_ESTABLISHED.
+  void recordHandshake(lws* wsi);
+
+  // Service thread: stores the session lws now holds for host:port. A TLS
+  // 1.3 ticket arrives after the handshake, so this is called again later
+  // in the connection's life. File writes are batched on `shard`.
+  void capture(LwsContext& shard, lws_vhost* vhost, const std::string& host, int port);
+
+  Stats stats();
+
+private:
+  TlsSessionCache() = default;
+
+  using SystemClock = std::chrono::system_clock;
+
+  struct Entry {
+    std::vector<uint8_t> blob;  // mbedtls_ssl_session_save() format
+    int64_t storedAt;           // unix seconds, so it means something next launch
+  };
+
+  static std::string keyFor(const std::string& host, int port);
+  static int64_t now();
+
+  void trimLocked();
+  void flush();
+  std::vector<uint8_t> serializeLocked() const;
+  void deserialize(const std::vector<uint8_t>& data);
+
+  std::mutex _mu;
+  Config _config;
+  std::unordered_map<std::string, Entry> _entries;
+  std::string _path;
+  std::vector<uint8_t> _key;
+  bool _flushPending = false;
+
+  std::atomic<uint64_t> _fullHandshakes{0};
+  std::atomic<uint64_t> _resumedHandshakes{0};
+  std::atomic<uint64_t> _offered{0};
+  std::atomic<uint64_t> _restored{0};
+};
+
+} // namespace margelo::nitro::nitrofetchwebsockets
@@ -7,6 +7,7 @@
 
 #include "WebSocketConnection.hpp"
 #include "LwsContext.hpp"
+#include "TlsSessionCache.hpp"
 
 #include <libwebsockets.h>
 #include <cstring>
@@ -58,6 +59,18 @@ static ParsedUrl parseUrl(const std::string& url) {
   return r;
 }
 
+// Sec-WebSocket-Extensions offer for `o`. Parameters at their RFC 7692
+// defaults are left out; client_max_window_bits is always sent so the server
+// may pick a smaller window.
+static std::string deflateOffer(const WebSocketConnectionBase::DeflateOptions& o) {
+  std::string offer = "permessage-deflate; client_max_window_bits";
+  if (o.clientMaxWindowBits < 15) offer += "=" + std::to_string(o.clientMaxWindowBits);
+  if (o.serverMaxWindowBits < 15) offer += "; server_max_window_bits=" + std::to_string(o.serverMaxWindowBits);
+  if (o.clientNoContextTakeover)  offer += "; client_no_context_takeover";
+  if (o.serverNoContextTakeover)  offer += "; server_no_context_takeover";
+  return offer;
+}
+
 
 
 int nitroWsCallback(lws* wsi, enum lws_callback_reasons reason,
@@ -127,9 +140,64 @@ int nitroWsCallback(lws* wsi, enum lws_callback_reasons reason,
   return 0;
 }
 
+int nitroPmdCallback(lws_context* context, const lws_extension* ext, lws* wsi,
+                     enum lws_extension_callback_reasons reason,
+                     void* user, void* in, size_t len) {
+  auto* conn = wsi ? static_cast<WebSocketConnection*>(lws_wsi_user(wsi)) : nullptr;
+  auto* ebufs = static_cast<lws_ext_pm_deflate_rx_ebufs*>(in);
+
+  switch (reason) {
+    case LWS_EXT_CB_PAYLOAD_TX: {
+      // Control frames and lws' own writes are not ours to account for.
+      if (!conn || !conn->pmdTxActive()) break;
+      if (conn->pmdSendUncompressed()) {
+        // Below minCompressSize: pass the payload through untouched. The
+        // deflate stream never sees it, so PRESEND leaves RSV1 clear.
+        ebufs->eb_out = ebufs->eb_in;
+        ebufs->eb_in.token += ebufs->eb_in.len;
+        ebufs->eb_in.len = 0;
+        return 0;
+      }
+      int before = ebufs->eb_in.len;
+      int n = lws_extension_callback_pm_deflate(context, ext, wsi, reason, user, in, len);
+      if (n >= 0) {
+        // Same test lws uses to decide the extension still has to drain.
+        conn->pmdTxProgress(static_cast<size_t>(before - ebufs->eb_in.len),
+                            static_cast<size_t>(ebufs->eb_out.len),
+                            n && ebufs->eb_in.len);
+      }
+      return n;
+    }
+
+    case LWS_EXT_CB_PAYLOAD_RX: {
+      if (!conn) break;
+      int before = ebufs->eb_in.len;
+      int n = lws_extension_callback_pm_deflate(context, ext, wsi, reason, user, in, len);
+      if (n >= 0) conn->pmdRxProgress(static_cast<size_t>(before - ebufs->eb_in.len));
+      return n;
+    }
 
+    default:
+      break;
+  }
+  return lws_extension_callback_pm_deflate(context, ext, wsi, reason, user, in, len);
+}
 
-WebSocketConnection::WebSocketConnection() {}
+
+
+WebSocketConnection::WebSocketConnection()
+  : _lws(LwsContext::pinLeastLoaded()) {}
+
+WebSocketConnection::~WebSocketConnection() {
+  if (_pinned.exchange(false)) _lws.unpin();
+}
+
+// lws is done with the wsi: the connection stops counting towards the
+// shard's load now rather than when JS lets go of the object.
+std::shared_ptr<WebSocketConnection> WebSocketConnection::takeSelfRef() {
+  if (_pinned.exchange(false)) _lws.unpin();
+  return std::move(_selfRef);
+}
 
 
 void WebSocketConnection::connect(
@@ -140,6 +208,7 @@ void WebSocketConnection::connect(
   _url   = url;
   _state = State::CONNECTING;
   _negotiatedProtocol.clear();
+  _extensions.clear();
 
 #if defined(NITRO_WS_TRACING)
   ATrace_beginSection(("NitroWS connect " + url).c_str());
@@ -152,7 +221,7 @@ void WebSocketConnection::connect(
     std::string what = e.what();
     _state = State::CLOSED;
     auto self = std::static_pointer_cast<WebSocketConnection>(shared_from_this());
-    LwsContext::instance().schedule([self, what]() {
+    _lws.schedule([self, what]() {
       if (self->_onError) self->_onError(what);
       self->fireClose(1006, "", false);
     });
@@ -165,11 +234,17 @@ void WebSocketConnection::connect(
     protocolStr += protocols[i];
   }
 
+  std::string offer;
+  size_t minCompressSize = 0;
   {
     std::lock_guard<std::mutex> lock(_pendingConnectMu);
     _pendingConnect = PendingConnect{
       parsed.host, parsed.port, parsed.path, protocolStr, protocols, parsed.isWss, headers
     };
+    if (_deflate.enabled) {
+      offer           = deflateOffer(_deflate);
+      minCompressSize = _deflate.minCompressSize;
+    }
   }
 
   auto self        = std::static_pointer_cast<WebSocketConnection>(shared_from_this());
@@ -179,11 +254,14 @@ void WebSocketConnection::connect(
   auto protoStr    = protocolStr;
   auto isWss       = parsed.isWss;
 
-  LwsContext::instance().schedule([self, host, port, path, protoStr, isWss]() {
+  _lws.schedule([self, host, port, path, protoStr, isWss,
+                 offer, minCompressSize]() {
+    if (!self->_pinned.exchange(true)) self->_lws.pin();
     self->_selfRef = self;
+    self->_minCompressSize = minCompressSize;
 
     lws_client_connect_info i = {};
-    i.context      = LwsContext::instance().ctx();
+    i.context      = self->_lws.ctx();
     i.address      = host.c_str();
     i.port         = port;
     i.path         = path.c_str();
@@ -192,10 +270,18 @@ void WebSocketConnection::connect(
     i.local_protocol_name = "nitro-ws";
     i.userdata     = self.get();
     i.ssl_connection = isWss ? LCCSCF_USE_SSL : 0;
+    // Falls back to the default vhost (no extensions) if lws cannot make one.
+    if (!offer.empty()) i.vhost = self->_lws.deflateVhost(offer);
+    if (!i.vhost) i.vhost = self->_lws.defaultVhost();
+
+    self->_tlsVhost = isWss ? i.vhost : nullptr;
+    self->_tlsHost  = host;
+    self->_tlsPort  = port;
+    if (self->_tlsVhost) TlsSessionCache::instance().offer(self->_tlsVhost, host, port);
 
     lws* wsi = lws_client_connect_via_info(&i);
     if (wsi == nullptr) {
-      self->_selfRef.reset();
+      self->takeSelfRef();
       if (self->_onError) self->_onError("lws_client_connect_via_info returned null");
       self->fireClose(1006, "", false);
     } else {
@@ -217,7 +303,7 @@ void WebSocketConnection::close(int code, const std::string& reason) {
   int closeCode = (code >= 1000 && code <= 4999) ? code : LWS_CLOSE_STATUS_NORMAL;
 
   auto self = std::static_pointer_cast<WebSocketConnection>(shared_from_this());
-  LwsContext::instance().schedule([self, prev, closeCode, reason]() {
+  _lws.schedule([self, prev, closeCode, reason]() {
     self->_localCloseCode   = closeCode;
     self->_localCloseReason = reason;
     if (!self->_wsi) return;
@@ -270,9 +356,48 @@ void WebSocketConnection::sendBinary(const uint8_t* data, size_t len) {
 #endif
 }
 
+void WebSocketConnection::postDelayed(std::chrono::microseconds delay, std::function<void()> fn) {
+  _lws.scheduleAfter(delay, std::move(fn));
+}
+
+void WebSocketConnection::setPerMessageDeflate(const DeflateOptions& options) {
+  std::lock_guard<std::mutex> lock(_pendingConnectMu);
+  _deflate = options;
+}
+
+WebSocketConnectionBase::CompressionStats WebSocketConnection::compressionStats() const {
+  std::lock_guard<std::mutex> lock(_statsMu);
+  return _stats;
+}
+
+void WebSocketConnection::recordSent(size_t bytes, size_t wireBytes, bool compressed) {
+  std::lock_guard<std::mutex> lock(_statsMu);
+  _stats.messagesSent++;
+  _stats.bytesSent       += bytes;
+  _stats.bytesSentOnWire += wireBytes;
+  if (compressed) {
+    _stats.messagesSentCompressed++;
+    _stats.lastSentRatio = wireBytes ? static_cast<double>(bytes) / wireBytes : 0;
+  }
+}
+
+void WebSocketConnection::recordReceived(size_t bytes, size_t wireBytes, bool compressed) {
+  std::lock_guard<std::mutex> lock(_statsMu);
+  _stats.messagesReceived++;
+  _stats.bytesReceived       += bytes;
+  _stats.bytesReceivedOnWire += wireBytes;
+  if (compressed) {
+    _stats.messagesReceivedCompressed++;
+    _stats.lastReceivedRatio = wireBytes ? static_cast<double>(bytes) / wireBytes : 0;
+  }
+}
+
 void WebSocketConnection::requestWrite() {
+  // One outstanding request covers every message queued before it runs.
+  if (_writeRequested.exchange(true, std::memory_order_acq_rel)) return;
   auto self = std::static_pointer_cast<WebSocketConnection>(shared_from_this());
-  LwsContext::instance().schedule([self]() {
+  _lws.schedule([self]() {
+    self->_writeRequested.store(false, std::memory_order_release);
     if (self->_wsi && self->_state == State::OPEN) {
       lws_callback_on_writable(self->_wsi);
     }
@@ -284,7 +409,7 @@ void WebSocketConnection::requestWrite() {
 // the JS thread would free a std::function mid-call.
 void WebSocketConnection::setOnOpen(OnOpen cb) {
   auto self = std::static_pointer_cast<WebSocketConnection>(shared_from_this());
-  LwsContext::instance().schedule([self, cb = std::move(cb)]() mutable {
+  _lws.schedule([self, cb = std::move(cb)]() mutable {
     self->_onOpen = std::move(cb);
     if (self->_onOpen && self->_openFired.exchange(false)) {
       self->_onOpen();
@@ -294,31 +419,26 @@ void WebSocketConnection::setOnOpen(OnOpen cb) {
 
 void WebSocketConnection::setOnMessage(OnMessage cb) {
   auto self = std::static_pointer_cast<WebSocketConnection>(shared_from_this());
-  LwsContext::instance().schedule([self, cb = std::move(cb)]() mutable {
+  _lws.schedule([self, cb = std::move(cb)]() mutable {
     self->_onMessage = std::move(cb);
     if (!self->_onMessage) return;
 
-    std::deque<BufferedMessage> buf;
-    {
-      std::lock_guard<std::mutex> lock(self->_msgMu);
-      buf = std::move(self->_msgBuffer);
-    }
-    for (auto& m : buf) {
-      self->_onMessage(m.data.data(), m.data.size(), m.isBinary);
+    for (auto& m : self->_pending.take()) {
+      self->_onMessage(std::move(m.data), m.isBinary);
     }
   });
 }
 
 void WebSocketConnection::setOnClose(OnClose cb) {
   auto self = std::static_pointer_cast<WebSocketConnection>(shared_from_this());
-  LwsContext::instance().schedule([self, cb = std::move(cb)]() mutable {
+  _lws.schedule([self, cb = std::move(cb)]() mutable {
     self->_onClose = std::move(cb);
   });
 }
 
 void WebSocketConnection::setOnError(OnError cb) {
   auto self = std::static_pointer_cast<WebSocketConnection>(shared_from_this());
-  LwsContext::instance().schedule([self, cb = std::move(cb)]() mutable {
+  _lws.schedule([self, cb = std::move(cb)]() mutable {
     self->_onError = std::move(cb);
   });
 }
@@ -331,6 +451,8 @@ void WebSocketConnection::handleFilterPreEstablish(lws* wsi) {
   char buf[256];
   int n = lws_hdr_copy(wsi, buf, sizeof(buf), WSI_TOKEN_PROTOCOL);
   if (n > 0) _negotiatedProtocol.assign(buf, static_cast<size_t>(n));
+  n = lws_hdr_copy(wsi, buf, sizeof(buf), WSI_TOKEN_EXTENSIONS);
+  if (n > 0) _extensions.assign(buf, static_cast<size_t>(n));
 }
 
 void WebSocketConnection::handleEstablished(lws* wsi) {
@@ -340,6 +462,12 @@ void WebSocketConnection::handleEstablished(lws* wsi) {
   _wsi = wsi;
   _redirectCount = 0;
 
+  if (_tlsVhost) {
+    TlsSessionCache::instance().recordHandshake(wsi);
+    captureTlsSession();
+    _tlsRecapture = true;
+  }
+
   State expected = State::CONNECTING;
   if (_state.compare_exchange_strong(expected, State::OPEN)) {
     if (_onOpen) {
@@ -353,14 +481,15 @@ void WebSocketConnection::handleEstablished(lws* wsi) {
 #endif
 }
 
-void WebSocketConnection::handleReceive(const void* in, size_t len, bool isBinary) {
+void WebSocketConnection::handleReceive(PooledPayload&& payload, bool isBinary) {
+  if (_tlsRecapture) {
+    _tlsRecapture = false;
+    captureTlsSession();
+  }
   if (_onMessage) {
-    _onMessage(static_cast<const uint8_t*>(in), len, isBinary);
-  } else {
-    std::vector<uint8_t> copy(static_cast<const uint8_t*>(in),
-                               static_cast<const uint8_t*>(in) + len);
-    std::lock_guard<std::mutex> lock(_msgMu);
-    _msgBuffer.push_back({ std::move(copy), isBinary });
+    _onMessage(std::move(payload), isBinary);
+  } else if (!_pending.push(std::move(payload), isBinary)) {
+    close(1008, "pending message limit exceeded");
   }
 }
 
@@ -372,9 +501,19 @@ void WebSocketConnection::handleReceiveFragment(lws* wsi, const void* in, size_t
   bool isFirst  = lws_is_first_fragment(wsi) != 0;
   bool isFinal  = lws_is_final_fragment(wsi) != 0;
 
+  // _rxWire is what the deflate extension consumed for this message; zero
+  // means it arrived uncompressed.
+  _rxRaw += len;
+  if (isFinal) {
+    bool compressed = _rxWire > 0;
+    recordReceived(_rxRaw, compressed ? _rxWire : _rxRaw, compressed);
+    _rxRaw  = 0;
+    _rxWire = 0;
+  }
+
   // Fast path: single-frame message (most common case)
   if (isFirst && isFinal) {
-    handleReceive(in, len, isBinary);
+    handleReceive(PooledPayload::copyOf(static_cast<const uint8_t*>(in), len), isBinary);
 #if defined(NITRO_WS_TRACING)
     ATrace_endSection();
 #endif
@@ -383,58 +522,107 @@ void WebSocketConnection::handleReceiveFragment(lws* wsi, const void* in, size_t
 
   // Multi-frame: accumulate fragments
   if (isFirst) {
-    _rxBuf.clear();
+    _rxBuf.reset();
     _rxBinary = isBinary;
   }
 
   // Max message size guard — close with 1009 (Message Too Big)
   if (_rxBuf.size() + len > kMaxMessageSize) {
-    _rxBuf.clear();
-    _rxBuf.shrink_to_fit();
+    _rxBuf.reset();
+    _rxRaw  = 0;
+    _rxWire = 0;
     close(1009, "message too large");
     return;
   }
 
-  const uint8_t* data = static_cast<const uint8_t*>(in);
-  _rxBuf.insert(_rxBuf.end(), data, data + len);
+  _rxBuf.append(static_cast<const uint8_t*>(in), len);
 
+  // The reassembled buffer becomes the message payload as is.
   if (isFinal) {
-    handleReceive(_rxBuf.data(), _rxBuf.size(), _rxBinary);
-    _rxBuf.clear();
-    _rxBuf.shrink_to_fit();
+    handleReceive(std::move(_rxBuf), _rxBinary);
+    _rxBuf.reset();
   }
 #if defined(NITRO_WS_TRACING)
   ATrace_endSection();
 #endif
 }
 
+// Writes as many queued messages as the socket takes in one callback, up
+// to kWriteBatchBytes / kWriteBatchTime, so a burst of small sends does not
+// cost one poll-loop round trip each. Messages are taken from _writeQueue
+// under a single lock into _txBatch, which is drained before the queue is
+// looked at again.
 int WebSocketConnection::handleWriteable(lws* wsi) {
-  OutMessage msg;
-  {
+  if (!_txDraining && _txBatch.empty()) {
     std::lock_guard<std::mutex> lock(_writeMu);
     if (_writeQueue.empty()) {
       return (_state == State::CLOSING) ? -1 : 0;
     }
-    msg = std::move(_writeQueue.front());
-    _writeQueue.pop_front();
+    size_t bytes = 0;
+    while (!_writeQueue.empty() && (bytes == 0 || bytes < kWriteBatchBytes)) {
+      bytes += _writeQueue.front().data.size() - LWS_PRE;
+      _txBatch.push_back(std::move(_writeQueue.front()));
+      _writeQueue.pop_front();
+    }
   }
 
-  size_t payloadSize = msg.data.size() - LWS_PRE;
-  _bufferedAmount -= std::min(_bufferedAmount.load(), payloadSize);
+  auto deadline = std::chrono::steady_clock::now() + kWriteBatchTime;
+  size_t written = 0;
+  do {
+    if (!_txDraining) {
+      _txMsg = std::move(_txBatch.front());
+      _txBatch.pop_front();
+      _bufferedAmount -= std::min(_bufferedAmount.load(), _txMsg.data.size() - LWS_PRE);
+      _txOffset   = 0;
+      _txWire     = 0;
+      _txStarting = true;
+    }
 
-  int mode = msg.isBinary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT;
-  lws_write(wsi, msg.data.data() + LWS_PRE, payloadSize,
-            static_cast<lws_write_protocol>(mode));
+    size_t payloadSize = _txMsg.data.size() - LWS_PRE;
+    int mode = _txMsg.isBinary ? LWS_WRITE_BINARY : LWS_WRITE_TEXT;
+    _txInWrite = true;
+    int n = lws_write(wsi, _txMsg.data.data() + LWS_PRE + _txOffset, payloadSize - _txOffset,
+                      static_cast<lws_write_protocol>(mode));
+    _txInWrite = false;
+    if (n < 0) return -1;
+    written += payloadSize;
+
+    if (_txStarting) {
+      // No extension saw the message: permessage-deflate is not in use.
+      _txStarting = false;
+      recordSent(payloadSize, payloadSize, false);
+    }
+    if (!_txDraining) _txMsg = {};
+    // A message the extension is still draining needs a fresh callback,
+    // and so does anything once lws has had to buffer output.
+  } while (!_txDraining && !_txBatch.empty() && !lws_send_pipe_choked(wsi) &&
+           written < kWriteBatchBytes && std::chrono::steady_clock::now() < deadline);
 
   {
     std::lock_guard<std::mutex> lock(_writeMu);
-    if (!_writeQueue.empty() || _state == State::CLOSING) {
+    if (_txDraining || !_txBatch.empty() || !_writeQueue.empty() || _state == State::CLOSING) {
       lws_callback_on_writable(wsi);
     }
   }
   return 0;
 }
 
+bool WebSocketConnection::pmdSendUncompressed() {
+  if (!_txStarting) return false;
+  _txStarting = false;
+  size_t payloadSize = _txMsg.data.size() - LWS_PRE;
+  if (payloadSize >= _minCompressSize) return false;
+  recordSent(payloadSize, payloadSize, false);
+  return true;
+}
+
+void WebSocketConnection::pmdTxProgress(size_t consumed, size_t wireBytes, bool draining) {
+  _txOffset  += consumed;
+  _txWire    += wireBytes;
+  _txDraining = draining;
+  if (!draining) recordSent(_txMsg.data.size() - LWS_PRE, _txWire, true);
+}
+
 void WebSocketConnection::handlePeerClose(const void* in, size_t len) {
   const auto* p = static_cast<const uint8_t*>(in);
   if (p && len >= 2) {
@@ -455,6 +643,7 @@ void WebSocketConnection::handleClose() {
   ATrace_beginSection("NitroWS close");
 #endif
   _wsi = nullptr;
+  if (_tlsVhost) captureTlsSession();
   if (_peerCloseCode > 0) {
     fireClose(_peerCloseCode, _peerCloseReason, true);
   } else if (_localCloseCode > 0) {
@@ -483,6 +672,13 @@ void WebSocketConnection::handleError(const char* msg) {
 #endif
 }
 
+// A TLS 1.3 ticket arrives after the handshake, usually just ahead of the
+// first message, so the session is taken at open, at the first message and
+// at close. Unchanged sessions are not stored again.
+void WebSocketConnection::captureTlsSession() {
+  TlsSessionCache::instance().capture(_lws, _tlsVhost, _tlsHost, _tlsPort);
+}
+
 void WebSocketConnection::handleRedirect(const std::string& location) {
   if (_redirectCount.fetch_add(1) >= kMaxRedirects) {
     _isRedirecting = false;
@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include "PendingMessages.hpp"
 #include "WebSocketConnectionBase.hpp"
 
 #include <libwebsockets.h>
+#include <chrono>
 #include <deque>
 #include <mutex>
 #include <atomic>
@@ -18,9 +20,12 @@
 namespace margelo::nitro::nitrofetchwebsockets {
 
 
+class LwsContext;
+
 class WebSocketConnection : public WebSocketConnectionBase {
 public:
   WebSocketConnection();
+  ~WebSocketConnection() override;
 
   WebSocketConnection(const WebSocketConnection&) = delete;
   WebSocketConnection& operator=(const WebSocketConnection&) = delete;
@@ -38,15 +43,21 @@ public:
   std::string extensions() const override { return _extensions; }
   size_t bufferedAmount() const override { return _bufferedAmount.load(); }
 
+  void setPerMessageDeflate(const DeflateOptions& options) override;
+  CompressionStats compressionStats() const override;
+
   void setOnOpen(OnOpen cb) override;
   void setOnMessage(OnMessage cb) override;
   void setOnClose(OnClose cb) override;
   void setOnError(OnError cb) override;
+  void postDelayed(std::chrono::microseconds delay, std::function<void()> fn) override;
+  void setPendingLimit(size_t maxBytes, BufferOverflow policy) override { _pending.setLimit(maxBytes, policy); }
+  uint64_t droppedPendingMessages() const override { return _pending.dropped(); }
 
   // lws callback handlers (internal, not part of the base interface)
   void handleFilterPreEstablish(lws* wsi);
   void handleEstablished(lws* wsi);
-  void handleReceive(const void* in, size_t len, bool isBinary);
+  void handleReceive(PooledPayload&& payload, bool isBinary);
   void handleReceiveFragment(lws* wsi, const void* in, size_t len);
   int  handleWriteable(lws* wsi);
   void handleClose();
@@ -55,15 +66,29 @@ public:
   void handleAppendHandshakeHeader(uint8_t** p, uint8_t* end, lws* wsi);
   void handleRedirect(const std::string& location);
   bool consumeRedirectFlag() { return _isRedirecting.exchange(false); }
-  std::shared_ptr<WebSocketConnection> takeSelfRef() { return std::move(_selfRef); }
+  std::shared_ptr<WebSocketConnection> takeSelfRef();
+
+  // permessage-deflate hooks for nitroPmdCallback (service thread).
+  bool pmdTxActive() const { return _txInWrite; }
+  bool pmdSendUncompressed();
+  void pmdTxProgress(size_t consumed, size_t wireBytes, bool draining);
+  void pmdRxProgress(size_t wireBytes) { _rxWire += wireBytes; }
 
 private:
   void requestWrite();
+  void captureTlsSession();
   void fireClose(int code, const std::string& reason, bool wasClean);
+  void recordSent(size_t bytes, size_t wireBytes, bool compressed);
+  void recordReceived(size_t bytes, size_t wireBytes, bool compressed);
 
   // Held while a wsi points at us, so lws can never call into a freed object.
   std::shared_ptr<WebSocketConnection> _selfRef;
 
+  // Shard this connection lives on, chosen at construction so every
+  // operation on it, before and after connect(), runs on one thread.
+  // _pinned says whether it currently counts towards the shard's load.
+  LwsContext& _lws;
+  std::atomic<bool> _pinned{true};
   lws*        _wsi = nullptr;
   std::string _url;
   std::string _negotiatedProtocol;
@@ -82,14 +107,18 @@ private:
   static constexpr int kMaxRedirects = 5;
   static constexpr size_t kMaxMessageSize = 16 * 1024 * 1024; // 16 MB
 
-  struct BufferedMessage { std::vector<uint8_t> data; bool isBinary; };
-  std::deque<BufferedMessage> _msgBuffer;
-  std::mutex _msgMu;
+  PendingMessages _pending;
 
   struct OutMessage { std::vector<uint8_t> data; bool isBinary; };
   std::deque<OutMessage> _writeQueue;
   std::mutex _writeMu;
   std::atomic<size_t> _bufferedAmount{0};
+  std::atomic<bool> _writeRequested{false};
+
+  // Per writeable callback; whichever limit is hit first ends the batch.
+  static constexpr size_t kWriteBatchBytes = 64 * 1024;
+  static constexpr std::chrono::microseconds kWriteBatchTime{2000};
+  std::deque<OutMessage> _txBatch;  // taken from _writeQueue, service thread only
 
   struct PendingConnect {
     std::string host;
@@ -101,11 +130,35 @@ private:
     std::unordered_map<std::string, std::string> headers;
   };
   std::optional<PendingConnect> _pendingConnect;
+  DeflateOptions _deflate;          // guarded by _pendingConnectMu
   std::mutex _pendingConnectMu;
 
-  std::vector<uint8_t> _rxBuf;
+  PooledPayload _rxBuf;
   bool _rxBinary = false;
 
+  // Where the TLS session of a wss connection is cached (TlsSessionCache),
+  // service thread only. _tlsVhost is null for ws://.
+  lws_vhost*  _tlsVhost = nullptr;
+  std::string _tlsHost;
+  int         _tlsPort = 0;
+  bool        _tlsRecapture = false;  // once more at the first message
+
+  // permessage-deflate bookkeeping, service thread only. A message the
+  // extension could not take in one lws_write() stays in _txMsg and is
+  // resubmitted from _txOffset on the next writeable callback.
+  size_t     _minCompressSize = 0;
+  OutMessage _txMsg;
+  size_t     _txOffset = 0;
+  size_t     _txWire = 0;
+  bool       _txInWrite = false;
+  bool       _txStarting = false;
+  bool       _txDraining = false;
+  size_t     _rxRaw = 0;
+  size_t     _rxWire = 0;
+
+  mutable std::mutex _statsMu;
+  CompressionStats   _stats;
+
   // LWS_CALLBACK_CLIENT_CLOSED carries no code/reason, so remember who closed
   // and why. Neither set => transport dropped without a handshake (1006).
   int _peerCloseCode = 0;
@@ -1,8 +1,10 @@
 #include <jni.h>
 #include <fbjni/fbjni.h>
 #include "NitroFetchWebsocketsOnLoad.hpp"
+#include "TlsSessionCache.hpp"
 #include "WebSocketPrewarmer.hpp"
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -58,3 +60,26 @@ Java_com_margelo_nitro_nitrofetchwebsockets_NitroWebSocketPrewarmer_nativePreWar
   margelo::nitro::nitrofetchwebsockets::WebSocketPrewarmer::instance()
     .preConnect(url, protocols, headers);
 }
+
+/**
+ * Called from NitroWebSocketTlsSessions.kt with the path of the session
+ * file and the AES key it unwrapped from the Android Keystore. Loads the
+ * sessions stored by an earlier launch, so it should run before the first
+ * prewarm.
+ */
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_margelo_nitro_nitrofetchwebsockets_NitroWebSocketTlsSessions_nativeEnablePersistence(
+    JNIEnv* env, jclass, jstring pathJs, jbyteArray keyJs) {
+
+  const char* pathCStr = env->GetStringUTFChars(pathJs, nullptr);
+  std::string path(pathCStr);
+  env->ReleaseStringUTFChars(pathJs, pathCStr);
+
+  std::vector<uint8_t> key(static_cast<size_t>(env->GetArrayLength(keyJs)));
+  env->GetByteArrayRegion(keyJs, 0, static_cast<jsize>(key.size()), reinterpret_cast<jbyte*>(key.data()));
+
+  bool ok = margelo::nitro::nitrofetchwebsockets::TlsSessionCache::instance()
+    .enablePersistence(path, key);
+  std::fill(key.begin(), key.end(), 0);
+  return ok ? JNI_TRUE : JNI_FALSE;
+}
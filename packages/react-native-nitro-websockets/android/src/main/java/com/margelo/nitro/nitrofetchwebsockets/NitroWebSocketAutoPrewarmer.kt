@@ -19,7 +19,7 @@ import javax.crypto.spec.GCMParameterSpec
  * Duplicate of [com.margelo.nitro.nitrofetch.NitroFetchSecureAtRest] — keep
  * [KEYSTORE_ALIAS], [ENC_PREFIX], [PREFS_NAME] in sync with nitro-fetch.
  */
-private object NitroWSSecureAtRest {
+internal object NitroWSSecureAtRest {
   const val PREFS_NAME = "nitro_fetch_storage"
   private const val KEYSTORE_ALIAS = "nitro_fetch_aes_gcm_v1"
   private const val ANDROID_KEYSTORE = "AndroidKeyStore"
@@ -0,0 +1,67 @@
+package com.margelo.nitro.nitrofetchwebsockets
+
+import android.content.Context
+import android.util.Base64
+import java.io.File
+import java.security.SecureRandom
+
+/**
+ * Keeps TLS sessions (tickets / session IDs) of `wss://` connections on
+ * disk, so the first connection after a cold start can resume instead of
+ * doing a full handshake.
+ *
+ * The file lives in `noBackupFilesDir` and is encrypted with AES-256-GCM.
+ * Its key is random per install and stored wrapped by the Android Keystore,
+ * the same way as the other secrets in [NitroWSSecureAtRest.PREFS_NAME].
+ *
+ * Call [enablePersistence] from `Application.onCreate()`, before
+ * [NitroWebSocketAutoPrewarmer.prewarmOnStart], so prewarmed sockets can
+ * already resume:
+ *
+ * ```kotlin
+ * override fun onCreate() {
+ *   super.onCreate()
+ *   NitroWebSocketTlsSessions.enablePersistence(this)
+ *   NitroWebSocketAutoPrewarmer.prewarmOnStart(this)
+ * }
+ * ```
+ */
+object NitroWebSocketTlsSessions {
+  private const val KEY_SESSION_KEY = "nitro_ws_tls_session_key"
+  private const val FILE_NAME = "nitro_ws_tls_sessions.bin"
+  private const val KEY_SIZE = 32
+
+  @JvmStatic
+  fun enablePersistence(context: Context): Boolean {
+    try {
+      System.loadLibrary("NitroFetchWebsockets")
+    } catch (_: UnsatisfiedLinkError) {
+      // Already loaded — ignore.
+    }
+    return try {
+      val file = File(context.noBackupFilesDir, FILE_NAME)
+      nativeEnablePersistence(file.absolutePath, getOrCreateKey(context))
+    } catch (_: Throwable) {
+      // Best-effort — without the file, sessions are still shared in memory.
+      false
+    }
+  }
+
+  private fun getOrCreateKey(context: Context): ByteArray {
+    val prefs = context.getSharedPreferences(NitroWSSecureAtRest.PREFS_NAME, Context.MODE_PRIVATE)
+    val stored = NitroWSSecureAtRest.getDecryptedForPrefs(prefs, KEY_SESSION_KEY)
+    if (stored != null) {
+      try {
+        val key = Base64.decode(stored, Base64.NO_WRAP)
+        if (key.size == KEY_SIZE) return key
+      } catch (_: IllegalArgumentException) {}
+    }
+    // A new key makes the old file unreadable; native overwrites it.
+    val key = ByteArray(KEY_SIZE).also { SecureRandom().nextBytes(it) }
+    NitroWSSecureAtRest.putEncrypted(prefs, KEY_SESSION_KEY, Base64.encodeToString(key, Base64.NO_WRAP))
+    return key
+  }
+
+  @JvmStatic
+  private external fun nativeEnablePersistence(path: String, key: ByteArray): Boolean
+}
@@ -6,6 +6,9 @@
 //
 
 #include "HybridWebSocket.hpp"
+#include "JSIByteSpan.hpp"
+#include "MessageBatcher.hpp"
+#include "Utf8Validate.hpp"
 #include "WebSocketPrewarmer.hpp"
 
 #if defined(__APPLE__)
@@ -13,11 +16,15 @@ namespace margelo::nitro::nitrofetchwebsockets {
   std::shared_ptr<WebSocketConnectionBase> createNWConnection();
 }
 #else
+#include "LwsContext.hpp"
+#include "TlsSessionCache.hpp"
 #include "WebSocketConnection.hpp"
 #endif
 
 #include <NitroModules/ArrayBuffer.hpp>
-#include <cstring>
+#include <NitroModules/JSIConverter.hpp>
+#include <NitroModules/PropNameIDCache.hpp>
+#include <algorithm>
 #include <memory>
 
 namespace margelo::nitro::nitrofetchwebsockets {
@@ -33,19 +40,173 @@ std::shared_ptr<ArrayBuffer> sharedEmptyPayload() {
   return empty;
 }
 
-std::shared_ptr<ArrayBuffer> copyPayloadToArrayBuffer(const uint8_t* data, size_t len) {
-  if (len == 0) {
+// The ArrayBuffer takes over the pooled storage; its finalizer hands it
+// back to the pool.
+std::shared_ptr<ArrayBuffer> payloadToArrayBuffer(PooledPayload&& payload) {
+  if (payload.empty()) {
     return sharedEmptyPayload();
   }
-  auto* raw = new uint8_t[len];
-  std::memcpy(raw, data, len);
-  return std::make_shared<NativeArrayBuffer>(raw, len, [raw]() { delete[] raw; });
+  auto r = payload.release();
+  return std::make_shared<NativeArrayBuffer>(r.data, r.size, [data = r.data, capacity = r.capacity]() {
+    PayloadPool::shared().release(data, capacity);
+  });
+}
+
+// RFC 6455 §8.1: a text message that is not valid UTF-8 fails the
+// connection with 1007. Runs on the receive thread, before any JS work.
+Utf8Kind checkText(const PooledPayload& payload,
+                   const std::weak_ptr<WebSocketConnectionBase>& weakConn) {
+  Utf8Kind kind = classifyUtf8(payload.data(), payload.size());
+  if (kind == Utf8Kind::Invalid) {
+    if (auto conn = weakConn.lock()) conn->close(1007, "invalid UTF-8");
+  }
+  return kind;
+}
+
+// WHATWG drops messages that arrive when readyState is not OPEN, and RFC
+// 6455 §7.1.7 forbids processing data once the connection is failed.
+// close() moves to CLOSING at once but the close itself is queued, so
+// frames already in the same receive pass would still reach JS without
+// this.
+bool isOpen(const std::weak_ptr<WebSocketConnectionBase>& weakConn) {
+  auto conn = weakConn.lock();
+  return conn && conn->state() == WebSocketConnectionBase::State::OPEN;
 }
 
 WebSocketConnectionBase::OnMessage makeHybridMessageBridge(
-    std::function<void(const HybridWebSocketMessageEvent&)> cb) {
-  return [cb = std::move(cb)](const uint8_t* data, size_t len, bool isBinary) {
-    cb(HybridWebSocketMessageEvent{ copyPayloadToArrayBuffer(data, len), isBinary });
+    std::function<void(const HybridWebSocketMessageEvent&)> cb,
+    std::weak_ptr<WebSocketConnectionBase> weakConn) {
+  return [cb = std::move(cb), weakConn = std::move(weakConn)](PooledPayload&& payload, bool isBinary) {
+    if (!isOpen(weakConn)) return;
+    if (!isBinary && checkText(payload, weakConn) == Utf8Kind::Invalid) return;
+    cb(HybridWebSocketMessageEvent{ payloadToArrayBuffer(std::move(payload)), isBinary });
+  };
+}
+
+// Text becomes a jsi::String built from the payload bytes (no ArrayBuffer,
+// no JS decode) and the payload goes back to the pool on return; binary
+// payloads become the ArrayBuffer's storage.
+jsi::Value payloadToJSI(jsi::Runtime& runtime, PooledPayload payload, bool isBinary, bool ascii) {
+  if (isBinary) {
+    return JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(
+        runtime, payloadToArrayBuffer(std::move(payload)));
+  }
+  if (ascii) {
+    return jsi::String::createFromAscii(
+        runtime, reinterpret_cast<const char*>(payload.data()), payload.size());
+  }
+  return jsi::String::createFromUtf8(runtime, payload.data(), payload.size());
+}
+
+// Same shape as WebSocketMessageEvent in src/index.ts.
+jsi::Object messageEvent(jsi::Runtime& runtime, BatchedMessage& message) {
+  jsi::Object event(runtime);
+  jsi::Value data = payloadToJSI(runtime, std::move(message.payload), message.isBinary, message.ascii);
+  if (message.isBinary) {
+    event.setProperty(runtime, PropNameIDCache::get(runtime, "data"), jsi::String::createFromAscii(runtime, ""));
+    event.setProperty(runtime, PropNameIDCache::get(runtime, "binaryData"), data);
+  } else {
+    event.setProperty(runtime, PropNameIDCache::get(runtime, "data"), data);
+  }
+  event.setProperty(runtime, PropNameIDCache::get(runtime, "isBinary"), message.isBinary);
+  return event;
+}
+
+// Validates text on the receive thread; returns false if the message was
+// rejected (and the connection failed) or the connection is no longer open.
+bool acceptMessage(const PooledPayload& payload, bool isBinary,
+                   const std::weak_ptr<WebSocketConnectionBase>& weakConn, bool* ascii) {
+  *ascii = false;
+  if (!isOpen(weakConn)) return false;
+  if (isBinary) return true;
+  Utf8Kind kind = checkText(payload, weakConn);
+  *ascii = kind == Utf8Kind::Ascii;
+  return kind != Utf8Kind::Invalid;
+}
+
+// Calls the handler straight through JSI on the JS thread.
+WebSocketConnectionBase::OnMessage makeRawMessageBridge(
+    HybridWebSocket::MessageHandler handler,
+    std::weak_ptr<WebSocketConnectionBase> weakConn) {
+  return [handler = std::move(handler), weakConn = std::move(weakConn)](PooledPayload&& payload, bool isBinary) {
+    bool ascii;
+    if (!acceptMessage(payload, isBinary, weakConn, &ascii)) return;
+    auto dispatcher = handler.dispatcher.lock();
+    if (!dispatcher) return;
+
+    auto box = std::make_shared<PooledPayload>(std::move(payload));
+    dispatcher->runAsync([handler, box, isBinary, ascii]() {
+      // The runtime went away before the message could be delivered.
+      if (!handler.function) return;
+      jsi::Runtime& runtime = *handler.runtime;
+      jsi::Value data = payloadToJSI(runtime, std::move(*box), isBinary, ascii);
+      handler.function->call(runtime, data, jsi::Value(isBinary));
+    });
+  };
+}
+
+// Each flush of the batcher is one JS call with an array of events. A
+// flush of one message goes to the single-message handler when there is
+// one, so idle traffic looks exactly like unbatched delivery.
+std::shared_ptr<MessageBatcher> makeMessageBatcher(
+    std::optional<HybridWebSocket::MessageHandler> single,
+    HybridWebSocket::MessageHandler batch,
+    std::chrono::microseconds window, size_t maxMessages,
+    std::weak_ptr<WebSocketConnectionBase> weakConn) {
+  auto flush = [single = std::move(single), batch = std::move(batch)](std::vector<BatchedMessage>&& messages) {
+    auto dispatcher = batch.dispatcher.lock();
+    if (!dispatcher) return;
+
+    auto box = std::make_shared<std::vector<BatchedMessage>>(std::move(messages));
+    dispatcher->runAsync([single, batch, box]() {
+      if (!batch.function) return;
+      jsi::Runtime& runtime = *batch.runtime;
+      auto& messages = *box;
+
+      if (messages.size() == 1 && single && single->function) {
+        auto& m = messages.front();
+        jsi::Value data = payloadToJSI(runtime, std::move(m.payload), m.isBinary, m.ascii);
+        single->function->call(runtime, data, jsi::Value(m.isBinary));
+        return;
+      }
+      jsi::Array events(runtime, messages.size());
+      for (size_t i = 0; i < messages.size(); ++i) {
+        events.setValueAtIndex(runtime, i, messageEvent(runtime, messages[i]));
+      }
+      batch.function->call(runtime, events);
+    });
+  };
+  auto timer = [weakConn](std::chrono::microseconds delay, std::function<void()> fn) {
+    if (auto conn = weakConn.lock()) conn->postDelayed(delay, std::move(fn));
+  };
+  return std::make_shared<MessageBatcher>(window, maxMessages, std::move(flush), std::move(timer));
+}
+
+// Feeds `batcher`.
+WebSocketConnectionBase::OnMessage makeBatchedMessageBridge(
+    std::shared_ptr<MessageBatcher> batcher,
+    std::weak_ptr<WebSocketConnectionBase> weakConn) {
+  return [batcher = std::move(batcher), weakConn = std::move(weakConn)](PooledPayload&& payload, bool isBinary) {
+    bool ascii;
+    if (!acceptMessage(payload, isBinary, weakConn, &ascii)) return;
+    batcher->push(BatchedMessage{ std::move(payload), isBinary, ascii });
+  };
+}
+
+// Resolves a raw handler argument: a function, or undefined/null to clear.
+std::optional<HybridWebSocket::MessageHandler> messageHandlerArg(
+    jsi::Runtime& runtime, const jsi::Value* args, size_t count, const char* method) {
+  if (count == 0 || args[0].isUndefined() || args[0].isNull()) {
+    return std::nullopt;
+  }
+  if (!args[0].isObject() || !args[0].getObject(runtime).isFunction(runtime)) [[unlikely]] {
+    throw jsi::JSError(runtime, std::string("WebSocket.") + method + "() expects a function");
+  }
+  auto cache = JSICache::getOrCreateCache(runtime);
+  return HybridWebSocket::MessageHandler{
+    &runtime,
+    Dispatcher::getRuntimeGlobalDispatcher(runtime),
+    cache.makeShared(args[0].getObject(runtime).getFunction(runtime)),
   };
 }
 
@@ -59,12 +220,21 @@ std::shared_ptr<WebSocketConnectionBase> HybridWebSocket::createConnection() {
 #endif
 }
 
-HybridWebSocket::HybridWebSocket() : HybridObject(TAG) {
-  _conn = createConnection();
-  bindCallbacks();
+HybridWebSocket::HybridWebSocket() : HybridObject(TAG) {}
+
+// Created on first use, so a HybridWebSocket that only reaches the
+// process-wide settings and stats (setServiceThreadCount, the TLS session
+// cache, the prewarm pool) never pins a shard or starts a service thread.
+WebSocketConnectionBase& HybridWebSocket::conn() {
+  if (!_conn) {
+    _conn = createConnection();
+    bindCallbacks();
+  }
+  return *_conn;
 }
 
 HybridWebSocket::~HybridWebSocket() {
+  if (!_conn) return;
   _conn->setOnOpen(nullptr);
   _conn->setOnMessage(nullptr);
   _conn->setOnClose(nullptr);
@@ -77,24 +247,26 @@ HybridWebSocket::~HybridWebSocket() {
   }
 }
 
+// Before the connection exists these report what a new one would.
 WebSocketReadyState HybridWebSocket::getReadyState() {
-  return static_cast<WebSocketReadyState>(_conn->state());
+  return _conn ? static_cast<WebSocketReadyState>(_conn->state())
+               : WebSocketReadyState::CONNECTING;
 }
 
 std::string HybridWebSocket::getUrl() {
-  return _conn->url();
+  return _conn ? _conn->url() : std::string();
 }
 
 double HybridWebSocket::getBufferedAmount() {
-  return static_cast<double>(_conn->bufferedAmount());
+  return _conn ? static_cast<double>(_conn->bufferedAmount()) : 0;
 }
 
 std::string HybridWebSocket::getProtocol() {
-  return _conn->protocol();
+  return _conn ? _conn->protocol() : std::string();
 }
 
 std::string HybridWebSocket::getExtensions() {
-  return _conn->extensions();
+  return _conn ? _conn->extensions() : std::string();
 }
 
 std::optional<std::function<void()>> HybridWebSocket::getOnOpen() {
@@ -102,6 +274,7 @@ std::optional<std::function<void()>> HybridWebSocket::getOnOpen() {
 }
 void HybridWebSocket::setOnOpen(const std::optional<std::function<void()>>& cb) {
   _onOpen = cb;
+  if (!_conn) return;
   _conn->setOnOpen(cb ? [cb = *cb]() { cb(); } : WebSocketConnectionBase::OnOpen{});
 }
 
@@ -111,11 +284,9 @@ std::optional<std::function<void(const HybridWebSocketMessageEvent&)>> HybridWeb
 void HybridWebSocket::setOnMessage(
     const std::optional<std::function<void(const HybridWebSocketMessageEvent&)>>& cb) {
   _onMessage = cb;
-  if (cb) {
-    _conn->setOnMessage(makeHybridMessageBridge(*cb));
-  } else {
-    _conn->setOnMessage({});
-  }
+  _messageHandler.reset();
+  _messagesHandler.reset();
+  bindMessageBridge();
 }
 
 std::optional<std::function<void(const WebSocketCloseEvent&)>> HybridWebSocket::getOnClose() {
@@ -124,6 +295,7 @@ std::optional<std::function<void(const WebSocketCloseEvent&)>> HybridWebSocket::
 void HybridWebSocket::setOnClose(
     const std::optional<std::function<void(const WebSocketCloseEvent&)>>& cb) {
   _onClose = cb;
+  if (!_conn) return;
   if (cb) {
     _conn->setOnClose([cb = *cb](int code, const std::string& reason, bool wasClean) {
       cb(WebSocketCloseEvent{ static_cast<double>(code), reason, wasClean });
@@ -138,6 +310,7 @@ std::optional<std::function<void(const std::string&)>> HybridWebSocket::getOnErr
 }
 void HybridWebSocket::setOnError(const std::optional<std::function<void(const std::string&)>>& cb) {
   _onError = cb;
+  if (!_conn) return;
   _conn->setOnError(cb ? [cb = *cb](const std::string& msg) { cb(msg); }
                        : WebSocketConnectionBase::OnError{});
 }
@@ -151,31 +324,317 @@ void HybridWebSocket::connect(
 
   auto existing = WebSocketPrewarmer::instance().tryGet(url);
   if (existing) {
-    _conn->setOnOpen(nullptr);
-    _conn->setOnMessage(nullptr);
-    _conn->setOnClose(nullptr);
-    _conn->setOnError(nullptr);
+    if (_conn) {
+      _conn->setOnOpen(nullptr);
+      _conn->setOnMessage(nullptr);
+      _conn->setOnClose(nullptr);
+      _conn->setOnError(nullptr);
+    }
 
     _conn = std::move(existing);
     bindCallbacks();
     return;
   }
 
-  _conn->connect(url, protocols, headers);
+  conn().connect(url, protocols, headers);
 }
 
 void HybridWebSocket::close(double code, const std::string& reason) {
-  _conn->close(static_cast<int>(code), reason);
+  conn().close(static_cast<int>(code), reason);
 }
 
 void HybridWebSocket::send(const std::string& data) {
-  _conn->send(data);
+  conn().send(data);
 }
 
 void HybridWebSocket::sendBinary(const std::shared_ptr<ArrayBuffer>& data) {
-  _conn->sendBinary(data->data(), data->size());
+  conn().sendBinary(data->data(), data->size());
 }
 
+void HybridWebSocket::setPerMessageDeflate(const PerMessageDeflateOptions& options) {
+  auto windowBits = [](const std::optional<double>& bits) {
+    return bits ? std::clamp(static_cast<int>(*bits), 9, 15) : 15;
+  };
+  WebSocketConnectionBase::DeflateOptions deflate;
+  deflate.enabled                 = true;
+  deflate.clientMaxWindowBits     = windowBits(options.clientMaxWindowBits);
+  deflate.serverMaxWindowBits     = windowBits(options.serverMaxWindowBits);
+  deflate.clientNoContextTakeover = options.clientNoContextTakeover.value_or(false);
+  deflate.serverNoContextTakeover = options.serverNoContextTakeover.value_or(false);
+  if (options.minCompressSize) {
+    deflate.minCompressSize = static_cast<size_t>(std::max(0.0, *options.minCompressSize));
+  }
+  conn().setPerMessageDeflate(deflate);
+}
+
+WebSocketCompressionStats HybridWebSocket::getCompressionStats() {
+  auto s = _conn ? _conn->compressionStats() : WebSocketConnectionBase::CompressionStats{};
+  return WebSocketCompressionStats(
+      static_cast<double>(s.messagesSent),
+      static_cast<double>(s.messagesSentCompressed),
+      static_cast<double>(s.bytesSent),
+      static_cast<double>(s.bytesSentOnWire),
+      s.lastSentRatio,
+      static_cast<double>(s.messagesReceived),
+      static_cast<double>(s.messagesReceivedCompressed),
+      static_cast<double>(s.bytesReceived),
+      static_cast<double>(s.bytesReceivedOnWire),
+      s.lastReceivedRatio);
+}
+
+ReceiveBufferPoolStats HybridWebSocket::getReceiveBufferPoolStats() {
+  auto s = PayloadPool::shared().stats();
+  return ReceiveBufferPoolStats(
+      static_cast<double>(s.hits),
+      static_cast<double>(s.misses),
+      static_cast<double>(s.residentBytes),
+      static_cast<double>(s.outstandingBytes));
+}
+
+ServiceQueueStats HybridWebSocket::getServiceQueueStats() {
+#if defined(__APPLE__)
+  // Network.framework does its own scheduling; there is no queue to report.
+  return ServiceQueueStats(0, 0, 0, 0, 0, 0, 0, 0);
+#else
+  // Summed over the service threads; latencies are the worst / the
+  // execution-weighted mean.
+  ServiceQueue::Stats total;
+  double latencySum = 0;
+  for (const auto& shard : LwsContext::shardStats()) {
+    const auto& q = shard.queue;
+    total.scheduled += q.scheduled;
+    total.wakeups   += q.wakeups;
+    total.heapTasks += q.heapTasks;
+    total.fullWaits += q.fullWaits;
+    total.depth     += q.depth;
+    total.maxDepth     = std::max(total.maxDepth, q.maxDepth);
+    total.maxLatencyUs = std::max(total.maxLatencyUs, q.maxLatencyUs);
+    latencySum += q.meanLatencyUs * static_cast<double>(q.scheduled - q.depth);
+  }
+  uint64_t executed = total.scheduled - total.depth;
+  return ServiceQueueStats(
+      static_cast<double>(total.scheduled),
+      static_cast<double>(total.wakeups),
+      static_cast<double>(total.heapTasks),
+      static_cast<double>(total.fullWaits),
+      static_cast<double>(total.depth),
+      static_cast<double>(total.maxDepth),
+      executed > 0 ? latencySum / static_cast<double>(executed) : 0,
+      total.maxLatencyUs);
+#endif
+}
+
+void HybridWebSocket::setServiceThreadCount(double count) {
+#if !defined(__APPLE__)
+  LwsContext::setShardCount(static_cast<size_t>(std::max(1.0, count)));
+#endif
+}
+
+void HybridWebSocket::configurePrewarmPool(const PrewarmPoolOptions& options) {
+  WebSocketPrewarmer::Config config;
+  if (options.maxPerEndpoint) {
+    config.maxPerEndpoint = static_cast<size_t>(std::max(1.0, *options.maxPerEndpoint));
+  }
+  if (options.idleTtlMs) {
+    config.idleTtl = std::chrono::milliseconds(static_cast<int64_t>(std::max(0.0, *options.idleTtlMs)));
+  }
+  if (options.ignoreQueryParams) config.ignoredQueryParams = *options.ignoreQueryParams;
+  config.ignoreAllQueryParams = options.ignoreAllQueryParams.value_or(false);
+  if (options.maxPendingBytes) {
+    config.maxPendingBytes = static_cast<size_t>(std::max(0.0, *options.maxPendingBytes));
+  }
+  if (options.closeOnPendingOverflow.value_or(false)) {
+    config.pendingOverflow = WebSocketConnectionBase::BufferOverflow::Close;
+  }
+  WebSocketPrewarmer::instance().configure(config);
+}
+
+PrewarmPoolStats HybridWebSocket::getPrewarmPoolStats() {
+  auto s = WebSocketPrewarmer::instance().stats();
+  return PrewarmPoolStats(
+      static_cast<double>(s.claims),
+      static_cast<double>(s.hits),
+      static_cast<double>(s.misses),
+      static_cast<double>(s.expired),
+      static_cast<double>(s.closed),
+      static_cast<double>(s.replaced),
+      static_cast<double>(s.droppedMessages),
+      static_cast<double>(s.warm));
+}
+
+// Network.framework resumes TLS sessions on its own and does not say when;
+// on iOS these are no-ops and the stats stay at zero.
+void HybridWebSocket::configureTlsSessionCache(const TlsSessionCacheOptions& options) {
+#if !defined(__APPLE__)
+  auto& cache = TlsSessionCache::instance();
+  auto config = cache.config();
+  if (options.maxEntries) {
+    config.maxEntries = static_cast<size_t>(std::max(1.0, *options.maxEntries));
+  }
+  if (options.maxAgeSeconds) {
+    config.maxAge = std::chrono::seconds(static_cast<int64_t>(std::max(0.0, *options.maxAgeSeconds)));
+  }
+  cache.configure(config);
+#endif
+}
+
+TlsSessionStats HybridWebSocket::getTlsSessionStats() {
+#if defined(__APPLE__)
+  return TlsSessionStats(0, 0, 0, 0, 0, false);
+#else
+  auto s = TlsSessionCache::instance().stats();
+  return TlsSessionStats(
+      static_cast<double>(s.fullHandshakes),
+      static_cast<double>(s.resumedHandshakes),
+      static_cast<double>(s.offered),
+      static_cast<double>(s.restored),
+      static_cast<double>(s.cached),
+      s.persistent);
+#endif
+}
+
+void HybridWebSocket::clearTlsSessionCache() {
+#if !defined(__APPLE__)
+  TlsSessionCache::instance().clear();
+#endif
+}
+
+std::vector<ServiceThreadStats> HybridWebSocket::getServiceThreadStats() {
+  std::vector<ServiceThreadStats> out;
+#if !defined(__APPLE__)
+  for (const auto& shard : LwsContext::shardStats()) {
+    out.emplace_back(
+        static_cast<double>(shard.index),
+        static_cast<double>(shard.connections),
+        static_cast<double>(shard.connectionsTotal),
+        shard.cpuTimeMs,
+        static_cast<double>(shard.queue.scheduled),
+        static_cast<double>(shard.queue.depth),
+        shard.queue.meanLatencyUs,
+        shard.queue.maxLatencyUs);
+  }
+#endif
+  return out;
+}
+
+// Both connection backends copy the payload before returning, so the span
+// may point straight into the JS heap.
+jsi::Value HybridWebSocket::sendBinaryRaw(jsi::Runtime& runtime,
+                                          const jsi::Value& /*thisVal*/,
+                                          const jsi::Value* args,
+                                          size_t count) {
+  ByteSpan span;
+  if (count == 0 || !tryGetByteSpan(runtime, args[0], &span)) [[unlikely]] {
+    throw jsi::JSError(runtime,
+                       "WebSocket.sendBinary() data must be an ArrayBuffer or ArrayBufferView");
+  }
+  conn().sendBinary(span.data, span.length);
+  return jsi::Value::undefined();
+}
+
+jsi::Value HybridWebSocket::setMessageHandlerRaw(jsi::Runtime& runtime,
+                                                 const jsi::Value& /*thisVal*/,
+                                                 const jsi::Value* args,
+                                                 size_t count) {
+  _messageHandler = messageHandlerArg(runtime, args, count, "setMessageHandler");
+  _onMessage.reset();
+  bindMessageBridge();
+  return jsi::Value::undefined();
+}
+
+jsi::Value HybridWebSocket::setMessagesHandlerRaw(jsi::Runtime& runtime,
+                                                  const jsi::Value& /*thisVal*/,
+                                                  const jsi::Value* args,
+                                                  size_t count) {
+  _messagesHandler = messageHandlerArg(runtime, args, count, "setMessagesHandler");
+  _onMessage.reset();
+  bindMessageBridge();
+  return jsi::Value::undefined();
+}
+
+void HybridWebSocket::setMessageBatching(double windowMs, double maxMessages) {
+  _batchWindow      = std::chrono::microseconds(static_cast<int64_t>(std::max(0.0, windowMs) * 1000));
+  _batchMaxMessages = static_cast<size_t>(std::max(1.0, maxMessages));
+  if (_messagesHandler) bindMessageBridge();
+}
+
+// Same registrations as the spec, except that "sendBinary" is bound to the
+// raw JSI variant so TypedArray/DataView views are accepted, plus the raw
+// "setMessageHandler" and "setMessagesHandler".
+void HybridWebSocket::loadHybridMethods() {
+  HybridObject::loadHybridMethods();
+  registerHybrids(this, [](Prototype& prototype) {
+    prototype.registerHybridGetter("readyState", &HybridWebSocket::getReadyState);
+    prototype.registerHybridGetter("url", &HybridWebSocket::getUrl);
+    prototype.registerHybridGetter("bufferedAmount", &HybridWebSocket::getBufferedAmount);
+    prototype.registerHybridGetter("protocol", &HybridWebSocket::getProtocol);
+    prototype.registerHybridGetter("extensions", &HybridWebSocket::getExtensions);
+    prototype.registerHybridGetter("onOpen", &HybridWebSocket::getOnOpen);
+    prototype.registerHybridSetter("onOpen", &HybridWebSocket::setOnOpen);
+    prototype.registerHybridGetter("onMessage", &HybridWebSocket::getOnMessage);
+    prototype.registerHybridSetter("onMessage", &HybridWebSocket::setOnMessage);
+    prototype.registerHybridGetter("onClose", &HybridWebSocket::getOnClose);
+    prototype.registerHybridSetter("onClose", &HybridWebSocket::setOnClose);
+    prototype.registerHybridGetter("onError", &HybridWebSocket::getOnError);
+    prototype.registerHybridSetter("onError", &HybridWebSocket::setOnError);
+    prototype.registerHybridMethod("connect", &HybridWebSocket::connect);
+    prototype.registerHybridMethod("close", &HybridWebSocket::close);
+    prototype.registerHybridMethod("send", &HybridWebSocket::send);
+    prototype.registerRawHybridMethod("sendBinary", 1, &HybridWebSocket::sendBinaryRaw);
+    prototype.registerRawHybridMethod("setMessageHandler", 1, &HybridWebSocket::setMessageHandlerRaw);
+    prototype.registerRawHybridMethod("setMessagesHandler", 1, &HybridWebSocket::setMessagesHandlerRaw);
+    prototype.registerHybridMethod("setPerMessageDeflate", &HybridWebSocket::setPerMessageDeflate);
+    prototype.registerHybridMethod("setMessageBatching", &HybridWebSocket::setMessageBatching);
+    prototype.registerHybridMethod("getCompressionStats", &HybridWebSocket::getCompressionStats);
+    prototype.registerHybridMethod("getReceiveBufferPoolStats", &HybridWebSocket::getReceiveBufferPoolStats);
+    prototype.registerHybridMethod("getServiceQueueStats", &HybridWebSocket::getServiceQueueStats);
+    prototype.registerHybridMethod("setServiceThreadCount", &HybridWebSocket::setServiceThreadCount);
+    prototype.registerHybridMethod("getServiceThreadStats", &HybridWebSocket::getServiceThreadStats);
+    prototype.registerHybridMethod("configurePrewarmPool", &HybridWebSocket::configurePrewarmPool);
+    prototype.registerHybridMethod("getPrewarmPoolStats", &HybridWebSocket::getPrewarmPoolStats);
+    prototype.registerHybridMethod("configureTlsSessionCache", &HybridWebSocket::configureTlsSessionCache);
+    prototype.registerHybridMethod("getTlsSessionStats", &HybridWebSocket::getTlsSessionStats);
+    prototype.registerHybridMethod("clearTlsSessionCache", &HybridWebSocket::clearTlsSessionCache);
+  });
+}
+
+
+// One receive path at a time: batched (when setMessagesHandler() is set,
+// with setMessageHandler() taking the idle singles), raw single, typed
+// onMessage.
+//
+// Replacing a batched path must not lose or reorder what its batcher still
+// holds. It is flushed to its handlers here, and, because the connection
+// may deliver a few more messages to the old path before the swap reaches
+// the receive thread, flushed again ahead of the first message on the new
+// one. Anything that still lands in it afterwards goes out on its timer.
+void HybridWebSocket::bindMessageBridge() {
+  if (!_conn) return;
+  std::shared_ptr<MessageBatcher> previous = std::move(_batcher);
+  if (previous) previous->flush();
+
+  WebSocketConnectionBase::OnMessage bridge;
+  if (_messagesHandler) {
+    _batcher = makeMessageBatcher(_messageHandler, *_messagesHandler,
+                                  _batchWindow, _batchMaxMessages, _conn);
+    bridge = makeBatchedMessageBridge(_batcher, _conn);
+  } else if (_messageHandler) {
+    bridge = makeRawMessageBridge(*_messageHandler, _conn);
+  } else if (_onMessage) {
+    bridge = makeHybridMessageBridge(*_onMessage, _conn);
+  }
+
+  if (previous && bridge) {
+    bridge = [previous, bridge = std::move(bridge)](PooledPayload&& payload, bool isBinary) mutable {
+      if (previous) {
+        previous->flush();
+        previous.reset();
+      }
+      bridge(std::move(payload), isBinary);
+    };
+  }
+  _conn->setOnMessage(std::move(bridge));
+}
 
 void HybridWebSocket::bindCallbacks() {
 
@@ -183,12 +642,7 @@ void HybridWebSocket::bindCallbacks() {
   _conn->setOnOpen(onOpen ? [onOpen = *onOpen]() { onOpen(); }
                            : WebSocketConnectionBase::OnOpen{});
 
-  auto onMsg = _onMessage;
-  if (onMsg) {
-    _conn->setOnMessage(makeHybridMessageBridge(*onMsg));
-  } else {
-    _conn->setOnMessage({});
-  }
+  bindMessageBridge();
 
   auto onClose = _onClose;
   if (onClose) {
@@ -8,14 +8,19 @@
 #pragma once
 
 #include "HybridHybridWebSocketSpec.hpp"
+#include "MessageBatcher.hpp"
 #include "WebSocketConnectionBase.hpp"
 
+#include <NitroModules/Dispatcher.hpp>
+#include <NitroModules/JSICache.hpp>
+#include <chrono>
 #include <functional>
 #include <optional>
 #include <memory>
 
 namespace margelo::nitro::nitrofetchwebsockets {
 
+namespace jsi = facebook::jsi;
 
 class HybridWebSocket : public HybridHybridWebSocketSpec {
 public:
@@ -47,17 +52,64 @@ public:
   void close(double code, const std::string& reason) override;
   void send(const std::string& data) override;
   void sendBinary(const std::shared_ptr<ArrayBuffer>& data) override;
+  void setPerMessageDeflate(const PerMessageDeflateOptions& options) override;
+  WebSocketCompressionStats getCompressionStats() override;
+  ReceiveBufferPoolStats getReceiveBufferPoolStats() override;
+  ServiceQueueStats getServiceQueueStats() override;
+  void setServiceThreadCount(double count) override;
+  std::vector<ServiceThreadStats> getServiceThreadStats() override;
+  void configurePrewarmPool(const PrewarmPoolOptions& options) override;
+  PrewarmPoolStats getPrewarmPoolStats() override;
+  void configureTlsSessionCache(const TlsSessionCacheOptions& options) override;
+  TlsSessionStats getTlsSessionStats() override;
+  void clearTlsSessionCache() override;
+  void setMessageBatching(double windowMs, double maxMessages) override;
+
+  // Raw JSI sendBinary(data): takes an ArrayBuffer or any ArrayBufferView
+  // and sends exactly the bytes the view covers, without a JS-side copy.
+  jsi::Value sendBinaryRaw(jsi::Runtime& runtime, const jsi::Value& thisVal,
+                           const jsi::Value* args, size_t count);
+
+  // Raw JSI setMessageHandler(fn | undefined): fn(data, isBinary) gets a
+  // string for text messages and an ArrayBuffer for binary ones. Replaces
+  // onMessage (and vice versa).
+  jsi::Value setMessageHandlerRaw(jsi::Runtime& runtime, const jsi::Value& thisVal,
+                                  const jsi::Value* args, size_t count);
+
+  // Raw JSI setMessagesHandler(fn | undefined): fn(events) gets arrays of
+  // { data, isBinary, binaryData? } gathered over the batching window. A
+  // lone message after a quiet window goes to setMessageHandler()'s handler
+  // when one is set.
+  jsi::Value setMessagesHandlerRaw(jsi::Runtime& runtime, const jsi::Value& thisVal,
+                                   const jsi::Value* args, size_t count);
+
+  // JS callback installed through setMessageHandler(), plus what is needed
+  // to call it from the receive thread.
+  struct MessageHandler {
+    jsi::Runtime* runtime;
+    std::weak_ptr<Dispatcher> dispatcher;
+    BorrowingReference<jsi::Function> function;
+  };
+
+  void loadHybridMethods() override;
 
   static std::shared_ptr<WebSocketConnectionBase> createConnection();
 
   inline static const char* TAG = "WebSocket";
 
 private:
+  WebSocketConnectionBase& conn();
   void bindCallbacks();
+  void bindMessageBridge();
 
-  std::shared_ptr<WebSocketConnectionBase> _conn;
+  std::shared_ptr<WebSocketConnectionBase> _conn;  // see conn()
   std::optional<std::function<void()>> _onOpen;
   std::optional<std::function<void(const HybridWebSocketMessageEvent&)>> _onMessage;
+  std::optional<MessageHandler> _messageHandler;
+  std::optional<MessageHandler> _messagesHandler;
+  std::shared_ptr<MessageBatcher> _batcher;  // behind the batched path, if bound
+  std::chrono::microseconds _batchWindow{16000};
+  size_t _batchMaxMessages = 128;
   std::optional<std::function<void(const WebSocketCloseEvent&)>> _onClose;
   std::optional<std::function<void(const std::string&)>> _onError;
 };
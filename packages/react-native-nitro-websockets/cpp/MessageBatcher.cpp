@@ -0,0 +1,57 @@
+/*
+ * MessageBatcher implementation. See MessageBatcher.hpp.
+ */
+
+#include "MessageBatcher.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+
+MessageBatcher::MessageBatcher(std::chrono::microseconds window, size_t maxMessages,
+                               Flush flush, Timer timer)
+  : _window(window),
+    _maxMessages(std::max<size_t>(1, maxMessages)),
+    _flush(std::move(flush)),
+    _timer(std::move(timer)) {}
+
+void MessageBatcher::push(BatchedMessage&& message) {
+  std::lock_guard<std::mutex> lock(_mu);
+  _pending.push_back(std::move(message));
+
+  auto now = Clock::now();
+  auto sinceFlush = std::chrono::duration_cast<std::chrono::microseconds>(now - _lastFlush);
+  bool idle = _pending.size() == 1 && !_timerArmed && sinceFlush >= _window;
+  if (idle || _pending.size() >= _maxMessages) {
+    flushLocked(now);
+    return;
+  }
+
+  if (!_timerArmed) {
+    _timerArmed = true;
+    _timer(std::max(_window - sinceFlush, std::chrono::microseconds(0)),
+           [self = shared_from_this()]() { self->onTimer(); });
+  }
+}
+
+void MessageBatcher::flush() {
+  std::lock_guard<std::mutex> lock(_mu);
+  if (!_pending.empty()) flushLocked(Clock::now());
+}
+
+void MessageBatcher::onTimer() {
+  std::lock_guard<std::mutex> lock(_mu);
+  _timerArmed = false;
+  if (!_pending.empty()) flushLocked(Clock::now());
+}
+
+void MessageBatcher::flushLocked(Clock::time_point now) {
+  std::vector<BatchedMessage> batch;
+  batch.swap(_pending);
+  _lastFlush = now;
+  _flush(std::move(batch));
+}
+
+} // namespace margelo::nitro::nitrofetchwebsockets
@@ -0,0 +1,63 @@
+/*
+ * Coalesces received messages into batches for one JS call.
+ *
+ * A message that arrives after at least one window of quiet is flushed on
+ * its own right away, so idle traffic sees no added latency. Messages that
+ * follow within the window are collected and flushed together when the
+ * window ends or the batch reaches maxMessages, whichever comes first.
+ * The flush callback runs with the batcher's lock held, so batches leave in
+ * arrival order even when the timer and the receive path race; keep it
+ * cheap (hand the batch to the JS thread, nothing more). An armed timer
+ * keeps the batcher alive, so a batch still pending when its owner lets go
+ * is flushed rather than dropped.
+ */
+
+#pragma once
+
+#include "PayloadPool.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+
+struct BatchedMessage {
+  PooledPayload payload;
+  bool isBinary;
+  bool ascii;     // text payload is pure ASCII
+};
+
+class MessageBatcher : public std::enable_shared_from_this<MessageBatcher> {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Flush = std::function<void(std::vector<BatchedMessage>&& batch)>;
+  using Timer = std::function<void(std::chrono::microseconds delay, std::function<void()> fn)>;
+
+  MessageBatcher(std::chrono::microseconds window, size_t maxMessages,
+                 Flush flush, Timer timer);
+
+  void push(BatchedMessage&& message);
+
+  // Hands whatever is pending to the flush callback now. Any thread.
+  void flush();
+
+private:
+  void flushLocked(Clock::time_point now);
+  void onTimer();
+
+  const std::chrono::microseconds _window;
+  const size_t _maxMessages;
+  Flush _flush;
+  Timer _timer;
+
+  std::mutex _mu;
+  std::vector<BatchedMessage> _pending;
+  Clock::time_point _lastFlush{};
+  bool _timerArmed = false;
+};
+
+} // namespace margelo::nitro::nitrofetchwebsockets
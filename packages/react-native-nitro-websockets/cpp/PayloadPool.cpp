@@ -0,0 +1,124 @@
+/*
+ * PayloadPool / PooledPayload implementation. See PayloadPool.hpp.
+ */
+
+#include "PayloadPool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+
+PayloadPool& PayloadPool::shared() {
+  static PayloadPool* pool = new PayloadPool();
+  return *pool;
+}
+
+size_t PayloadPool::classIndex(size_t capacity) {
+  return static_cast<size_t>(std::countr_zero(capacity)) - kMinClassShift;
+}
+
+uint8_t* PayloadPool::allocate(size_t minCapacity, size_t* capacity) {
+  size_t cap = minCapacity > (size_t(1) << kMaxClassShift)
+    ? minCapacity
+    : std::bit_ceil(std::max(minCapacity, size_t(1) << kMinClassShift));
+  *capacity = cap;
+
+  {
+    std::lock_guard<std::mutex> lock(_mu);
+    _stats.outstandingBytes += cap;
+    if (cap <= (size_t(1) << kMaxClassShift)) {
+      auto& list = _free[classIndex(cap)];
+      if (!list.empty()) {
+        uint8_t* data = list.back();
+        list.pop_back();
+        _stats.hits++;
+        _stats.residentBytes -= cap;
+        return data;
+      }
+    }
+    _stats.misses++;
+  }
+  return new uint8_t[cap];
+}
+
+void PayloadPool::release(uint8_t* data, size_t capacity) noexcept {
+  if (!data) return;
+  {
+    std::lock_guard<std::mutex> lock(_mu);
+    _stats.outstandingBytes -= capacity;
+    if (capacity <= (size_t(1) << kMaxClassShift)) {
+      auto& list = _free[classIndex(capacity)];
+      size_t maxIdle = std::max<size_t>(2, kMaxIdleBytesPerClass / capacity);
+      if (list.size() < maxIdle) {
+        list.push_back(data);
+        _stats.residentBytes += capacity;
+        return;
+      }
+    }
+  }
+  delete[] data;
+}
+
+PayloadPool::Stats PayloadPool::stats() const {
+  std::lock_guard<std::mutex> lock(_mu);
+  return _stats;
+}
+
+
+PooledPayload::PooledPayload(PooledPayload&& other) noexcept
+  : _data(std::exchange(other._data, nullptr)),
+    _size(std::exchange(other._size, 0)),
+    _capacity(std::exchange(other._capacity, 0)) {}
+
+PooledPayload& PooledPayload::operator=(PooledPayload&& other) noexcept {
+  if (this != &other) {
+    reset();
+    _data     = std::exchange(other._data, nullptr);
+    _size     = std::exchange(other._size, 0);
+    _capacity = std::exchange(other._capacity, 0);
+  }
+  return *this;
+}
+
+PooledPayload PooledPayload::copyOf(const uint8_t* data, size_t len) {
+  PooledPayload p;
+  p.append(data, len);
+  return p;
+}
+
+void PooledPayload::append(const uint8_t* data, size_t len) {
+  if (len == 0) return;
+  if (_size + len > _capacity) {
+    // Fragmented messages grow geometrically, like a vector would.
+    size_t newCapacity = 0;
+    uint8_t* grown = PayloadPool::shared().allocate(
+        std::max(_size + len, _capacity * 2), &newCapacity);
+    if (_size > 0) std::memcpy(grown, _data, _size);
+    PayloadPool::shared().release(_data, _capacity);
+    _data     = grown;
+    _capacity = newCapacity;
+  }
+  std::memcpy(_data + _size, data, len);
+  _size += len;
+}
+
+void PooledPayload::reset() noexcept {
+  PayloadPool::shared().release(_data, _capacity);
+  _data     = nullptr;
+  _size     = 0;
+  _capacity = 0;
+}
+
+PooledPayload::Released PooledPayload::release() noexcept {
+  Released r{ _data, _size, _capacity };
+  _data     = nullptr;
+  _size     = 0;
+  _capacity = 0;
+  return r;
+}
+
+} // namespace margelo::nitro::nitrofetchwebsockets
@@ -0,0 +1,91 @@
+/*
+ * Recycled storage for inbound message payloads.
+ *
+ * Every received message becomes a JS ArrayBuffer that owns its bytes until
+ * the GC collects it. Allocating each one with new[] churns malloc on the
+ * receive thread, so payloads come from power-of-two size classes instead
+ * and go back to a per-class free list when the ArrayBuffer is finalized.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+
+class PayloadPool {
+public:
+  struct Stats {
+    uint64_t hits = 0;             // allocations served from a free list
+    uint64_t misses = 0;           // allocations that went to the heap
+    size_t   residentBytes = 0;    // idle storage held by the free lists
+    size_t   outstandingBytes = 0; // storage owned by live payloads
+  };
+
+  // Process-wide pool. Never destroyed, so ArrayBuffers finalized during
+  // runtime teardown can still return their storage.
+  static PayloadPool& shared();
+
+  // At least `minCapacity` bytes; `*capacity` receives the usable size,
+  // which must be passed back to release().
+  uint8_t* allocate(size_t minCapacity, size_t* capacity);
+  void release(uint8_t* data, size_t capacity) noexcept;
+
+  Stats stats() const;
+
+private:
+  PayloadPool() = default;
+
+  static constexpr size_t kMinClassShift = 6;   // 64 B
+  static constexpr size_t kMaxClassShift = 20;  // 1 MiB; larger is unpooled
+  static constexpr size_t kNumClasses = kMaxClassShift - kMinClassShift + 1;
+  // Idle bytes kept per class (at least two buffers) before frees go to
+  // the heap.
+  static constexpr size_t kMaxIdleBytesPerClass = 256 * 1024;
+
+  static size_t classIndex(size_t capacity);
+
+  mutable std::mutex _mu;
+  std::array<std::vector<uint8_t*>, kNumClasses> _free;
+  Stats _stats;
+};
+
+
+// Move-only owner of one pooled payload.
+class PooledPayload {
+public:
+  PooledPayload() = default;
+  PooledPayload(PooledPayload&& other) noexcept;
+  PooledPayload& operator=(PooledPayload&& other) noexcept;
+  PooledPayload(const PooledPayload&) = delete;
+  PooledPayload& operator=(const PooledPayload&) = delete;
+  ~PooledPayload() { reset(); }
+
+  static PooledPayload copyOf(const uint8_t* data, size_t len);
+
+  uint8_t* data() const { return _data; }
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+
+  // Appends `len` bytes, moving to a larger size class when full.
+  void append(const uint8_t* data, size_t len);
+  // Returns the storage to the pool.
+  void reset() noexcept;
+
+  // Gives up ownership. The caller returns `data`/`capacity` to
+  // PayloadPool::shared().release() when done.
+  struct Released { uint8_t* data; size_t size; size_t capacity; };
+  Released release() noexcept;
+
+private:
+  uint8_t* _data = nullptr;
+  size_t   _size = 0;
+  size_t   _capacity = 0;
+};
+
+} // namespace margelo::nitro::nitrofetchwebsockets
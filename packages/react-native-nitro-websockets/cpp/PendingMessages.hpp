@@ -0,0 +1,77 @@
+/*
+ * Messages received while no message callback is installed, which is the
+ * case for a prewarmed socket until JS claims it. Replayed in order once a
+ * callback is set. Optionally capped in payload bytes, so a warm socket on
+ * a busy feed that is never claimed cannot grow without bound.
+ */
+
+#pragma once
+
+#include "WebSocketConnectionBase.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+
+class PendingMessages {
+public:
+  struct Message { PooledPayload data; bool isBinary; };
+  using Overflow = WebSocketConnectionBase::BufferOverflow;
+
+  // 0 = unlimited. Applies from the next push().
+  void setLimit(size_t maxBytes, Overflow policy) {
+    std::lock_guard<std::mutex> lock(_mu);
+    _maxBytes = maxBytes;
+    _policy   = policy;
+  }
+
+  // Returns false if the message broke the limit under Overflow::Close;
+  // it is dropped and the caller should fail the connection.
+  bool push(PooledPayload&& data, bool isBinary) {
+    std::lock_guard<std::mutex> lock(_mu);
+    size_t size = data.size();
+    if (_maxBytes > 0 && _bytes + size > _maxBytes) {
+      if (_policy == Overflow::Close) {
+        _dropped++;
+        return false;
+      }
+      while (!_messages.empty() && _bytes + size > _maxBytes) {
+        _bytes -= _messages.front().data.size();
+        _messages.pop_front();
+        _dropped++;
+      }
+      if (size > _maxBytes) {
+        _dropped++;
+        return true;
+      }
+    }
+    _bytes += size;
+    _messages.push_back({ std::move(data), isBinary });
+    return true;
+  }
+
+  std::deque<Message> take() {
+    std::lock_guard<std::mutex> lock(_mu);
+    _bytes = 0;
+    return std::exchange(_messages, {});
+  }
+
+  uint64_t dropped() const {
+    std::lock_guard<std::mutex> lock(_mu);
+    return _dropped;
+  }
+
+private:
+  mutable std::mutex _mu;
+  std::deque<Message> _messages;
+  size_t   _bytes = 0;
+  size_t   _maxBytes = 0;
+  Overflow _policy = Overflow::DropOldest;
+  uint64_t _dropped = 0;
+};
+
+} // namespace margelo::nitro::nitrofetchwebsockets
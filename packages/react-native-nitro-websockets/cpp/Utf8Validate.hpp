@@ -0,0 +1,67 @@
+/*
+ * UTF-8 validation for inbound text messages.
+ *
+ * RFC 6455 §8.1 requires failing the connection when a text message is not
+ * valid UTF-8, so every text payload is checked once on the receive thread
+ * before it reaches JS. ASCII runs are skipped eight bytes at a time;
+ * multi-byte sequences are checked against the well-formed ranges of
+ * Unicode Table 3-7 (no overlongs, surrogates or code points past
+ * U+10FFFF). simdutf lives in react-native-nitro-text-decoder's native
+ * library and is not linked into this one.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+enum class Utf8Kind { Invalid, Ascii, Utf8 };
+
+// Ascii lets the caller use the cheaper jsi::String::createFromAscii.
+inline Utf8Kind classifyUtf8(const uint8_t* s, size_t n) {
+  bool ascii = true;
+  size_t i = 0;
+  while (i < n) {
+    while (n - i >= 8) {
+      uint64_t word;
+      std::memcpy(&word, s + i, 8);
+      if (word & 0x8080808080808080ULL) break;
+      i += 8;
+    }
+    if (i == n) break;
+
+    uint8_t c = s[i];
+    if (c < 0x80) {
+      ++i;
+      continue;
+    }
+    ascii = false;
+
+    size_t len;
+    uint8_t lo = 0x80, hi = 0xBF;  // allowed range of the second byte
+    if (c >= 0xC2 && c <= 0xDF) {
+      len = 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+      len = 3;
+      if (c == 0xE0) lo = 0xA0;       // overlong
+      else if (c == 0xED) hi = 0x9F;  // surrogates
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      len = 4;
+      if (c == 0xF0) lo = 0x90;       // overlong
+      else if (c == 0xF4) hi = 0x8F;  // > U+10FFFF
+    } else {
+      return Utf8Kind::Invalid;
+    }
+    if (n - i < len || s[i + 1] < lo || s[i + 1] > hi) return Utf8Kind::Invalid;
+    for (size_t k = 2; k < len; ++k) {
+      if ((s[i + k] & 0xC0) != 0x80) return Utf8Kind::Invalid;
+    }
+    i += len;
+  }
+  return ascii ? Utf8Kind::Ascii : Utf8Kind::Utf8;
+}
+
+} // namespace margelo::nitro::nitrofetchwebsockets
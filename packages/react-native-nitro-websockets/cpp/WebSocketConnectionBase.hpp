@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include "PayloadPool.hpp"
+
+#include <chrono>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -21,10 +24,39 @@ public:
   enum class State { CONNECTING = 0, OPEN = 1, CLOSING = 2, CLOSED = 3 };
 
   using OnOpen    = std::function<void()>;
-  using OnMessage = std::function<void(const uint8_t* data, size_t len, bool isBinary)>;
+  // The payload is handed over; backends reassemble straight into it.
+  using OnMessage = std::function<void(PooledPayload&& payload, bool isBinary)>;
   using OnClose   = std::function<void(int code, const std::string& reason, bool wasClean)>;
   using OnError   = std::function<void(const std::string& msg)>;
 
+  // RFC 7692 permessage-deflate offer, applied by the next connect().
+  struct DeflateOptions {
+    bool   enabled = false;
+    int    clientMaxWindowBits = 15;     // 9..15
+    int    serverMaxWindowBits = 15;     // 9..15
+    bool   clientNoContextTakeover = false;
+    bool   serverNoContextTakeover = false;
+    size_t minCompressSize = 64;         // smaller messages go out uncompressed
+  };
+
+  // What a capped pending-message buffer does when a message would not fit.
+  enum class BufferOverflow { DropOldest, Close };
+
+  // Payload bytes before and after compression; "ratio" is uncompressed /
+  // compressed size of the last compressed message.
+  struct CompressionStats {
+    uint64_t messagesSent = 0;
+    uint64_t messagesSentCompressed = 0;
+    uint64_t bytesSent = 0;
+    uint64_t bytesSentOnWire = 0;
+    double   lastSentRatio = 0;
+    uint64_t messagesReceived = 0;
+    uint64_t messagesReceivedCompressed = 0;
+    uint64_t bytesReceived = 0;
+    uint64_t bytesReceivedOnWire = 0;
+    double   lastReceivedRatio = 0;
+  };
+
   virtual ~WebSocketConnectionBase() = default;
 
   virtual void connect(const std::string& url,
@@ -40,6 +72,21 @@ public:
   virtual std::string extensions() const = 0;
   virtual size_t bufferedAmount() const = 0;
 
+  // Runs `fn` once `delay` has passed, on a background thread (the lws
+  // service thread on Android). It may run concurrently with message
+  // callbacks, so `fn` must synchronise with them.
+  virtual void postDelayed(std::chrono::microseconds delay, std::function<void()> fn) = 0;
+
+  // Caps the payload bytes held for replay while no message callback is
+  // set (0 = unlimited, the default). With BufferOverflow::Close the
+  // connection is failed with 1008 instead of dropping messages.
+  virtual void setPendingLimit(size_t maxBytes, BufferOverflow policy) = 0;
+  virtual uint64_t droppedPendingMessages() const = 0;
+
+  // Backends without compression support keep the defaults.
+  virtual void setPerMessageDeflate(const DeflateOptions& /*options*/) {}
+  virtual CompressionStats compressionStats() const { return {}; }
+
   virtual void setOnOpen(OnOpen cb) = 0;
   virtual void setOnMessage(OnMessage cb) = 0;
   virtual void setOnClose(OnClose cb) = 0;
@@ -7,13 +7,16 @@
 
 #include "WebSocketPrewarmer.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <optional>
+
 #if defined(__APPLE__)
 namespace margelo::nitro::nitrofetchwebsockets {
   std::shared_ptr<WebSocketConnectionBase> createNWConnection();
 }
 #else
 #include "WebSocketConnection.hpp"
-#include "LwsContext.hpp"
 #endif
 
 namespace margelo::nitro::nitrofetchwebsockets {
@@ -26,33 +29,218 @@ static std::shared_ptr<WebSocketConnectionBase> createPlatformConnection() {
 #endif
 }
 
+static std::string toLower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return s;
+}
+
 WebSocketPrewarmer& WebSocketPrewarmer::instance() {
   static WebSocketPrewarmer inst;
   return inst;
 }
 
+std::string WebSocketPrewarmer::endpointKey(const std::string& url, const Config& config) {
+  std::string rest = url.substr(0, url.find('#'));
+
+  std::string scheme;
+  size_t schemeEnd = rest.find("://");
+  if (schemeEnd != std::string::npos) {
+    scheme = toLower(rest.substr(0, schemeEnd));
+    rest   = rest.substr(schemeEnd + 3);
+  }
+
+  size_t authorityEnd = rest.find_first_of("/?");
+  std::string authority = toLower(rest.substr(0, authorityEnd));
+  rest = authorityEnd == std::string::npos ? "" : rest.substr(authorityEnd);
+
+  if ((scheme == "wss" && authority.ends_with(":443")) ||
+      (scheme == "ws" && authority.ends_with(":80"))) {
+    authority.erase(authority.rfind(':'));
+  }
+
+  size_t queryStart = rest.find('?');
+  std::string path  = rest.substr(0, queryStart);
+  if (path.empty()) path = "/";
+
+  std::vector<std::string> params;
+  if (queryStart != std::string::npos && !config.ignoreAllQueryParams) {
+    std::string query = rest.substr(queryStart + 1);
+    size_t pos = 0;
+    while (pos <= query.size()) {
+      size_t amp = query.find('&', pos);
+      if (amp == std::string::npos) amp = query.size();
+      std::string param = query.substr(pos, amp - pos);
+      pos = amp + 1;
+      if (param.empty()) continue;
+      std::string name = param.substr(0, param.find('='));
+      if (std::find(config.ignoredQueryParams.begin(), config.ignoredQueryParams.end(), name) !=
+          config.ignoredQueryParams.end()) {
+        continue;
+      }
+      params.push_back(std::move(param));
+    }
+    std::sort(params.begin(), params.end());
+  }
+
+  std::string key = scheme + "://" + authority + path;
+  for (size_t i = 0; i < params.size(); ++i) {
+    key += (i == 0 ? '?' : '&');
+    key += params[i];
+  }
+  return key;
+}
+
+void WebSocketPrewarmer::configure(const Config& config) {
+  std::lock_guard<std::mutex> lock(_mu);
+  _config = config;
+  _config.maxPerEndpoint = std::max<size_t>(1, _config.maxPerEndpoint);
+
+  // Re-key under the new normalization and apply the new limits.
+  auto pool = std::move(_pool);
+  _pool.clear();
+  for (auto& [key, warms] : pool) {
+    for (auto& warm : warms) {
+      warm.conn->setPendingLimit(_config.maxPendingBytes, _config.pendingOverflow);
+      _pool[endpointKey(warm.url, _config)].push_back(std::move(warm));
+    }
+  }
+  for (auto& [key, warms] : _pool) {
+    std::sort(warms.begin(), warms.end(),
+              [](const Warm& a, const Warm& b) { return a.warmedAt < b.warmedAt; });
+    while (warms.size() > _config.maxPerEndpoint) {
+      _stats.replaced++;
+      dropLocked(warms.front());
+      warms.pop_front();
+    }
+  }
+  sweepLocked(Clock::now());
+}
+
 void WebSocketPrewarmer::preConnect(
     const std::string& url,
     const std::vector<std::string>& protocols,
     const std::unordered_map<std::string, std::string>& headers) {
-#if !defined(__APPLE__)
-  LwsContext::instance();
-#endif
-
   auto conn = createPlatformConnection();
-  conn->connect(url, protocols, headers);
 
-  std::lock_guard<std::mutex> lock(_mu);
-  _entries[url] = std::move(conn);
+  std::chrono::milliseconds ttl;
+  {
+    std::lock_guard<std::mutex> lock(_mu);
+    conn->setPendingLimit(_config.maxPendingBytes, _config.pendingOverflow);
+    ttl = _config.idleTtl;
+
+    auto now = Clock::now();
+    sweepLocked(now);
+    auto& warms = _pool[endpointKey(url, _config)];
+    while (warms.size() >= _config.maxPerEndpoint) {
+      _stats.replaced++;
+      dropLocked(warms.front());
+      warms.pop_front();
+    }
+    warms.push_back(Warm{ url, conn, now });
+  }
+
+  conn->connect(url, protocols, headers);
+  armExpiry(conn, ttl);
 }
 
 std::shared_ptr<WebSocketConnectionBase> WebSocketPrewarmer::tryGet(const std::string& url) {
   std::lock_guard<std::mutex> lock(_mu);
-  auto it = _entries.find(url);
-  if (it == _entries.end()) return nullptr;
-  auto conn = std::move(it->second);
-  _entries.erase(it);
+  _stats.claims++;
+  sweepLocked(Clock::now());
+
+  auto it = _pool.find(endpointKey(url, _config));
+  if (it == _pool.end()) {
+    _stats.misses++;
+    return nullptr;
+  }
+  auto& warms = it->second;
+  auto pick = std::find_if(warms.begin(), warms.end(), [](const Warm& w) {
+    return w.conn->state() == WebSocketConnectionBase::State::OPEN;
+  });
+  if (pick == warms.end()) pick = warms.begin();
+
+  auto conn = std::move(pick->conn);
+  warms.erase(pick);
+  if (warms.empty()) _pool.erase(it);
+
+  _stats.hits++;
+  _stats.droppedMessages += conn->droppedPendingMessages();
+  // The claimer delivers messages as they come from here on.
+  conn->setPendingLimit(0, WebSocketConnectionBase::BufferOverflow::DropOldest);
   return conn;
 }
 
+WebSocketPrewarmer::Stats WebSocketPrewarmer::stats() {
+  std::lock_guard<std::mutex> lock(_mu);
+  sweepLocked(Clock::now());
+  Stats s = _stats;
+  for (auto& [key, warms] : _pool) {
+    s.warm += warms.size();
+    for (auto& warm : warms) s.droppedMessages += warm.conn->droppedPendingMessages();
+  }
+  return s;
+}
+
+void WebSocketPrewarmer::dropLocked(Warm& warm) {
+  _stats.droppedMessages += warm.conn->droppedPendingMessages();
+  auto state = warm.conn->state();
+  if (state == WebSocketConnectionBase::State::CONNECTING ||
+      state == WebSocketConnectionBase::State::OPEN) {
+    warm.conn->close(1001, "");
+  }
+  warm.conn.reset();
+}
+
+// Evicts closed connections and closes the ones past idleTtl.
+void WebSocketPrewarmer::sweepLocked(Clock::time_point now) {
+  for (auto it = _pool.begin(); it != _pool.end();) {
+    auto& warms = it->second;
+    for (auto w = warms.begin(); w != warms.end();) {
+      auto state = w->conn->state();
+      if (state == WebSocketConnectionBase::State::CLOSING ||
+          state == WebSocketConnectionBase::State::CLOSED) {
+        _stats.closed++;
+      } else if (now - w->warmedAt >= _config.idleTtl) {
+        _stats.expired++;
+      } else {
+        ++w;
+        continue;
+      }
+      dropLocked(*w);
+      w = warms.erase(w);
+    }
+    it = warms.empty() ? _pool.erase(it) : std::next(it);
+  }
+}
+
+void WebSocketPrewarmer::armExpiry(const std::shared_ptr<WebSocketConnectionBase>& conn,
+                                   std::chrono::milliseconds delay) {
+  std::weak_ptr<WebSocketConnectionBase> weakConn = conn;
+  conn->postDelayed(delay, [weakConn]() {
+    WebSocketPrewarmer::instance().onExpiryTimer(weakConn);
+  });
+}
+
+void WebSocketPrewarmer::onExpiryTimer(const std::weak_ptr<WebSocketConnectionBase>& weakConn) {
+  auto conn = weakConn.lock();
+  if (!conn) return;
+
+  std::optional<std::chrono::milliseconds> rearm;
+  {
+    std::lock_guard<std::mutex> lock(_mu);
+    auto now = Clock::now();
+    sweepLocked(now);
+    // Still warm: idleTtl was raised since the timer was armed.
+    for (auto& [key, warms] : _pool) {
+      for (auto& warm : warms) {
+        if (warm.conn == conn) {
+          rearm = std::chrono::ceil<std::chrono::milliseconds>(warm.warmedAt + _config.idleTtl - now);
+        }
+      }
+    }
+  }
+  if (rearm) armExpiry(conn, *rearm);
+}
+
 } // namespace margelo::nitro::nitrofetchwebsockets
@@ -9,6 +9,8 @@
 
 #include "WebSocketConnectionBase.hpp"
 
+#include <chrono>
+#include <deque>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -18,21 +20,72 @@
 namespace margelo::nitro::nitrofetchwebsockets {
 
 
+// Pool of connections opened before JS asks for them (app start), keyed by
+// endpoint rather than exact URL so a rotated query token still matches
+// when it is configured as ignorable.
 class WebSocketPrewarmer {
 public:
+  struct Config {
+    size_t maxPerEndpoint = 1;                    // oldest is closed to make room
+    std::chrono::milliseconds idleTtl{60000};     // unclaimed connections are closed after this
+    bool ignoreAllQueryParams = false;
+    std::vector<std::string> ignoredQueryParams;  // e.g. "token"
+    size_t maxPendingBytes = 1024 * 1024;         // per warm connection, 0 = unlimited
+    WebSocketConnectionBase::BufferOverflow pendingOverflow =
+        WebSocketConnectionBase::BufferOverflow::DropOldest;
+  };
+
+  struct Stats {
+    uint64_t claims = 0;    // tryGet() calls
+    uint64_t hits = 0;      // ... that got a warm connection
+    uint64_t misses = 0;
+    uint64_t expired = 0;   // closed after idleTtl
+    uint64_t closed = 0;    // found closed by the server or network
+    uint64_t replaced = 0;  // closed to stay within maxPerEndpoint
+    uint64_t droppedMessages = 0;  // pending messages dropped by the byte cap
+    size_t   warm = 0;      // in the pool now
+  };
+
   static WebSocketPrewarmer& instance();
 
+  // Applies to connections already in the pool too.
+  void configure(const Config& config);
+
   void preConnect(const std::string& url,
                   const std::vector<std::string>& protocols,
                   const std::unordered_map<std::string, std::string>& headers);
 
+  // A warm connection for the same endpoint as `url`, preferring one that
+  // is already open. Ownership passes to the caller.
   std::shared_ptr<WebSocketConnectionBase> tryGet(const std::string& url);
 
+  Stats stats();
+
+  // Scheme and host lower-cased, default port dropped, path kept, query
+  // parameters filtered by `config` and sorted. Fragment dropped.
+  static std::string endpointKey(const std::string& url, const Config& config);
+
 private:
   WebSocketPrewarmer() = default;
 
+  using Clock = std::chrono::steady_clock;
+
+  struct Warm {
+    std::string url;
+    std::shared_ptr<WebSocketConnectionBase> conn;
+    Clock::time_point warmedAt;
+  };
+
+  void sweepLocked(Clock::time_point now);
+  void dropLocked(Warm& warm);
+  void armExpiry(const std::shared_ptr<WebSocketConnectionBase>& conn,
+                 std::chrono::milliseconds delay);
+  void onExpiryTimer(const std::weak_ptr<WebSocketConnectionBase>& weakConn);
+
   std::mutex _mu;
-  std::unordered_map<std::string, std::shared_ptr<WebSocketConnectionBase>> _entries;
+  Config _config;
+  Stats _stats;
+  std::unordered_map<std::string, std::deque<Warm>> _pool;
 };
 
 } // namespace margelo::nitro::nitrofetchwebsockets
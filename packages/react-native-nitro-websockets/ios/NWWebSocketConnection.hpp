@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "PendingMessages.hpp"
 #include "WebSocketConnectionBase.hpp"
 
 #include <deque>
@@ -36,6 +37,9 @@ public:
   void setOnMessage(OnMessage cb) override;
   void setOnClose(OnClose cb) override;
   void setOnError(OnError cb) override;
+  void postDelayed(std::chrono::microseconds delay, std::function<void()> fn) override;
+  void setPendingLimit(size_t maxBytes, BufferOverflow policy) override { _pending.setLimit(maxBytes, policy); }
+  uint64_t droppedPendingMessages() const override { return _pending.dropped(); }
 
 private:
   struct Impl;
@@ -57,9 +61,7 @@ private:
   std::atomic<bool> _openFired{false};
   std::atomic<bool> _closeFired{false};
 
-  struct BufferedMessage { std::vector<uint8_t> data; bool isBinary; };
-  std::deque<BufferedMessage> _msgBuffer;
-  std::mutex _msgMu;
+  PendingMessages _pending;
 
   // Who closed and why (0 = didn't). Neither set => transport dropped
   // without a close handshake (1006).
@@ -395,12 +395,11 @@ void NWWebSocketConnection::scheduleReceive() {
           const auto* bytes = static_cast<const uint8_t*>(utf8.bytes);
           size_t len = utf8.length;
 
+          auto payload = PooledPayload::copyOf(bytes, len);
           if (onMsg) {
-            onMsg(bytes, len, false);
-          } else {
-            std::vector<uint8_t> copy(bytes, bytes + len);
-            std::lock_guard<std::mutex> lock(conn->_msgMu);
-            conn->_msgBuffer.push_back({std::move(copy), false});
+            onMsg(std::move(payload), false);
+          } else if (!conn->_pending.push(std::move(payload), false)) {
+            conn->close(1008, "pending message limit exceeded");
           }
           break;
         }
@@ -410,12 +409,11 @@ void NWWebSocketConnection::scheduleReceive() {
             static_cast<const uint8_t*>(message.data.bytes);
           size_t len = message.data.length;
 
+          auto payload = PooledPayload::copyOf(bytes, len);
           if (onMsg) {
-            onMsg(bytes, len, true);
-          } else {
-            std::vector<uint8_t> copy(bytes, bytes + len);
-            std::lock_guard<std::mutex> lock(conn->_msgMu);
-            conn->_msgBuffer.push_back({std::move(copy), true});
+            onMsg(std::move(payload), true);
+          } else if (!conn->_pending.push(std::move(payload), true)) {
+            conn->close(1008, "pending message limit exceeded");
           }
           break;
         }
@@ -441,7 +439,6 @@ void NWWebSocketConnection::setOnOpen(OnOpen cb) {
 }
 
 void NWWebSocketConnection::setOnMessage(OnMessage cb) {
-  std::deque<BufferedMessage> replay;
   OnMessage onMsg;
   {
     std::lock_guard<std::mutex> lock(_cbMu);
@@ -449,12 +446,8 @@ void NWWebSocketConnection::setOnMessage(OnMessage cb) {
     onMsg = _onMessage;
   }
   if (onMsg) {
-    {
-      std::lock_guard<std::mutex> lock(_msgMu);
-      replay = std::move(_msgBuffer);
-    }
-    for (auto& m : replay) {
-      onMsg(m.data.data(), m.data.size(), m.isBinary);
+    for (auto& m : _pending.take()) {
+      onMsg(std::move(m.data), m.isBinary);
     }
   }
 }
@@ -469,6 +462,13 @@ void NWWebSocketConnection::setOnError(OnError cb) {
   _onError = std::move(cb);
 }
 
+void NWWebSocketConnection::postDelayed(std::chrono::microseconds delay, std::function<void()> fn) {
+  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, std::chrono::nanoseconds(delay).count()),
+                 dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0), ^{
+    fn();
+  });
+}
+
 
 // ── Property getters ─────────────────────────────────────────────────────
 
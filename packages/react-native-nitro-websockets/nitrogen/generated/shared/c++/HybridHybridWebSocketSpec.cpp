@@ -31,6 +31,18 @@ namespace margelo::nitro::nitrofetchwebsockets {
       prototype.registerHybridMethod("close", &HybridHybridWebSocketSpec::close);
       prototype.registerHybridMethod("send", &HybridHybridWebSocketSpec::send);
       prototype.registerHybridMethod("sendBinary", &HybridHybridWebSocketSpec::sendBinary);
+      prototype.registerHybridMethod("setPerMessageDeflate", &HybridHybridWebSocketSpec::setPerMessageDeflate);
+      prototype.registerHybridMethod("setMessageBatching", &HybridHybridWebSocketSpec::setMessageBatching);
+      prototype.registerHybridMethod("getCompressionStats", &HybridHybridWebSocketSpec::getCompressionStats);
+      prototype.registerHybridMethod("getReceiveBufferPoolStats", &HybridHybridWebSocketSpec::getReceiveBufferPoolStats);
+      prototype.registerHybridMethod("getServiceQueueStats", &HybridHybridWebSocketSpec::getServiceQueueStats);
+      prototype.registerHybridMethod("setServiceThreadCount", &HybridHybridWebSocketSpec::setServiceThreadCount);
+      prototype.registerHybridMethod("getServiceThreadStats", &HybridHybridWebSocketSpec::getServiceThreadStats);
+      prototype.registerHybridMethod("configurePrewarmPool", &HybridHybridWebSocketSpec::configurePrewarmPool);
+      prototype.registerHybridMethod("getPrewarmPoolStats", &HybridHybridWebSocketSpec::getPrewarmPoolStats);
+      prototype.registerHybridMethod("configureTlsSessionCache", &HybridHybridWebSocketSpec::configureTlsSessionCache);
+      prototype.registerHybridMethod("getTlsSessionStats", &HybridHybridWebSocketSpec::getTlsSessionStats);
+      prototype.registerHybridMethod("clearTlsSessionCache", &HybridHybridWebSocketSpec::clearTlsSessionCache);
     });
   }
 
@@ -19,6 +19,24 @@ namespace margelo::nitro::nitrofetchwebsockets { enum class WebSocketReadyState;
 namespace margelo::nitro::nitrofetchwebsockets { struct HybridWebSocketMessageEvent; }
 // Forward declaration of `WebSocketCloseEvent` to properly resolve imports.
 namespace margelo::nitro::nitrofetchwebsockets { struct WebSocketCloseEvent; }
+// Forward declaration of `PerMessageDeflateOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct PerMessageDeflateOptions; }
+// Forward declaration of `WebSocketCompressionStats` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct WebSocketCompressionStats; }
+// Forward declaration of `ReceiveBufferPoolStats` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct ReceiveBufferPoolStats; }
+// Forward declaration of `ServiceQueueStats` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct ServiceQueueStats; }
+// Forward declaration of `ServiceThreadStats` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct ServiceThreadStats; }
+// Forward declaration of `PrewarmPoolOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct PrewarmPoolOptions; }
+// Forward declaration of `PrewarmPoolStats` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct PrewarmPoolStats; }
+// Forward declaration of `TlsSessionCacheOptions` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct TlsSessionCacheOptions; }
+// Forward declaration of `TlsSessionStats` to properly resolve imports.
+namespace margelo::nitro::nitrofetchwebsockets { struct TlsSessionStats; }
 
 #include "WebSocketReadyState.hpp"
 #include <string>
@@ -29,6 +47,15 @@ namespace margelo::nitro::nitrofetchwebsockets { struct WebSocketCloseEvent; }
 #include <vector>
 #include <unordered_map>
 #include <NitroModules/ArrayBuffer.hpp>
+#include "PerMessageDeflateOptions.hpp"
+#include "WebSocketCompressionStats.hpp"
+#include "ReceiveBufferPoolStats.hpp"
+#include "ServiceQueueStats.hpp"
+#include "ServiceThreadStats.hpp"
+#include "PrewarmPoolOptions.hpp"
+#include "PrewarmPoolStats.hpp"
+#include "TlsSessionCacheOptions.hpp"
+#include "TlsSessionStats.hpp"
 
 namespace margelo::nitro::nitrofetchwebsockets {
 
@@ -77,6 +104,18 @@ namespace margelo::nitro::nitrofetchwebsockets {
       virtual void close(double code, const std::string& reason) = 0;
       virtual void send(const std::string& data) = 0;
       virtual void sendBinary(const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual void setPerMessageDeflate(const PerMessageDeflateOptions& options) = 0;
+      virtual void setMessageBatching(double windowMs, double maxMessages) = 0;
+      virtual WebSocketCompressionStats getCompressionStats() = 0;
+      virtual ReceiveBufferPoolStats getReceiveBufferPoolStats() = 0;
+      virtual ServiceQueueStats getServiceQueueStats() = 0;
+      virtual void setServiceThreadCount(double count) = 0;
+      virtual std::vector<ServiceThreadStats> getServiceThreadStats() = 0;
+      virtual void configurePrewarmPool(const PrewarmPoolOptions& options) = 0;
+      virtual PrewarmPoolStats getPrewarmPoolStats() = 0;
+      virtual void configureTlsSessionCache(const TlsSessionCacheOptions& options) = 0;
+      virtual TlsSessionStats getTlsSessionStats() = 0;
+      virtual void clearTlsSessionCache() = 0;
 
     protected:
       // Hybrid Setup
@@ -0,0 +1,99 @@
+///
+/// PerMessageDeflateOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PerMessageDeflateOptions).
+   */
+  struct PerMessageDeflateOptions final {
+  public:
+    std::optional<double> clientMaxWindowBits     SWIFT_PRIVATE;
+    std::optional<double> serverMaxWindowBits     SWIFT_PRIVATE;
+    std::optional<bool> clientNoContextTakeover     SWIFT_PRIVATE;
+    std::optional<bool> serverNoContextTakeover     SWIFT_PRIVATE;
+    std::optional<double> minCompressSize     SWIFT_PRIVATE;
+
+  public:
+    PerMessageDeflateOptions() = default;
+    explicit PerMessageDeflateOptions(std::optional<double> clientMaxWindowBits, std::optional<double> serverMaxWindowBits, std::optional<bool> clientNoContextTakeover, std::optional<bool> serverNoContextTakeover, std::optional<double> minCompressSize): clientMaxWindowBits(clientMaxWindowBits), serverMaxWindowBits(serverMaxWindowBits), clientNoContextTakeover(clientNoContextTakeover), serverNoContextTakeover(serverNoContextTakeover), minCompressSize(minCompressSize) {}
+
+  public:
+    friend bool operator==(const PerMessageDeflateOptions& lhs, const PerMessageDeflateOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ PerMessageDeflateOptions <> JS PerMessageDeflateOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::PerMessageDeflateOptions> final {
+    static inline margelo::nitro::nitrofetchwebsockets::PerMessageDeflateOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::PerMessageDeflateOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "clientMaxWindowBits"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "serverMaxWindowBits"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "clientNoContextTakeover"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "serverNoContextTakeover"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "minCompressSize")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::PerMessageDeflateOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "clientMaxWindowBits"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.clientMaxWindowBits));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "serverMaxWindowBits"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.serverMaxWindowBits));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "clientNoContextTakeover"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.clientNoContextTakeover));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "serverNoContextTakeover"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.serverNoContextTakeover));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "minCompressSize"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.minCompressSize));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "clientMaxWindowBits")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "serverMaxWindowBits")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "clientNoContextTakeover")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "serverNoContextTakeover")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "minCompressSize")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,105 @@
+///
+/// PrewarmPoolOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <vector>
+#include <optional>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PrewarmPoolOptions).
+   */
+  struct PrewarmPoolOptions final {
+  public:
+    std::optional<double> maxPerEndpoint     SWIFT_PRIVATE;
+    std::optional<double> idleTtlMs     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> ignoreQueryParams     SWIFT_PRIVATE;
+    std::optional<bool> ignoreAllQueryParams     SWIFT_PRIVATE;
+    std::optional<double> maxPendingBytes     SWIFT_PRIVATE;
+    std::optional<bool> closeOnPendingOverflow     SWIFT_PRIVATE;
+
+  public:
+    PrewarmPoolOptions() = default;
+    explicit PrewarmPoolOptions(std::optional<double> maxPerEndpoint, std::optional<double> idleTtlMs, std::optional<std::vector<std::string>> ignoreQueryParams, std::optional<bool> ignoreAllQueryParams, std::optional<double> maxPendingBytes, std::optional<bool> closeOnPendingOverflow): maxPerEndpoint(maxPerEndpoint), idleTtlMs(idleTtlMs), ignoreQueryParams(ignoreQueryParams), ignoreAllQueryParams(ignoreAllQueryParams), maxPendingBytes(maxPendingBytes), closeOnPendingOverflow(closeOnPendingOverflow) {}
+
+  public:
+    friend bool operator==(const PrewarmPoolOptions& lhs, const PrewarmPoolOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ PrewarmPoolOptions <> JS PrewarmPoolOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::PrewarmPoolOptions> final {
+    static inline margelo::nitro::nitrofetchwebsockets::PrewarmPoolOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::PrewarmPoolOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxPerEndpoint"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "idleTtlMs"))),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "ignoreQueryParams"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "ignoreAllQueryParams"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxPendingBytes"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "closeOnPendingOverflow")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::PrewarmPoolOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxPerEndpoint"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxPerEndpoint));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "idleTtlMs"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.idleTtlMs));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "ignoreQueryParams"), JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.ignoreQueryParams));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "ignoreAllQueryParams"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.ignoreAllQueryParams));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxPendingBytes"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxPendingBytes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "closeOnPendingOverflow"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.closeOnPendingOverflow));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxPerEndpoint")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "idleTtlMs")))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "ignoreQueryParams")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "ignoreAllQueryParams")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxPendingBytes")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "closeOnPendingOverflow")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
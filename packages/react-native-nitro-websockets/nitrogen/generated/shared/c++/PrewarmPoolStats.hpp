@@ -0,0 +1,111 @@
+///
+/// PrewarmPoolStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PrewarmPoolStats).
+   */
+  struct PrewarmPoolStats final {
+  public:
+    double claims     SWIFT_PRIVATE;
+    double hits     SWIFT_PRIVATE;
+    double misses     SWIFT_PRIVATE;
+    double expired     SWIFT_PRIVATE;
+    double closed     SWIFT_PRIVATE;
+    double replaced     SWIFT_PRIVATE;
+    double droppedMessages     SWIFT_PRIVATE;
+    double warm     SWIFT_PRIVATE;
+
+  public:
+    PrewarmPoolStats() = default;
+    explicit PrewarmPoolStats(double claims, double hits, double misses, double expired, double closed, double replaced, double droppedMessages, double warm): claims(claims), hits(hits), misses(misses), expired(expired), closed(closed), replaced(replaced), droppedMessages(droppedMessages), warm(warm) {}
+
+  public:
+    friend bool operator==(const PrewarmPoolStats& lhs, const PrewarmPoolStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ PrewarmPoolStats <> JS PrewarmPoolStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::PrewarmPoolStats> final {
+    static inline margelo::nitro::nitrofetchwebsockets::PrewarmPoolStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::PrewarmPoolStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "claims"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "hits"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "misses"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "expired"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "closed"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "replaced"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "droppedMessages"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "warm")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::PrewarmPoolStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "claims"), JSIConverter<double>::toJSI(runtime, arg.claims));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "hits"), JSIConverter<double>::toJSI(runtime, arg.hits));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "misses"), JSIConverter<double>::toJSI(runtime, arg.misses));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "expired"), JSIConverter<double>::toJSI(runtime, arg.expired));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "closed"), JSIConverter<double>::toJSI(runtime, arg.closed));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "replaced"), JSIConverter<double>::toJSI(runtime, arg.replaced));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "droppedMessages"), JSIConverter<double>::toJSI(runtime, arg.droppedMessages));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "warm"), JSIConverter<double>::toJSI(runtime, arg.warm));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "claims")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "hits")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "misses")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "expired")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "closed")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "replaced")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "droppedMessages")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "warm")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
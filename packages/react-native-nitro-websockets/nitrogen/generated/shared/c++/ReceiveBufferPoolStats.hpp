@@ -0,0 +1,95 @@
+///
+/// ReceiveBufferPoolStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ReceiveBufferPoolStats).
+   */
+  struct ReceiveBufferPoolStats final {
+  public:
+    double hits     SWIFT_PRIVATE;
+    double misses     SWIFT_PRIVATE;
+    double residentBytes     SWIFT_PRIVATE;
+    double outstandingBytes     SWIFT_PRIVATE;
+
+  public:
+    ReceiveBufferPoolStats() = default;
+    explicit ReceiveBufferPoolStats(double hits, double misses, double residentBytes, double outstandingBytes): hits(hits), misses(misses), residentBytes(residentBytes), outstandingBytes(outstandingBytes) {}
+
+  public:
+    friend bool operator==(const ReceiveBufferPoolStats& lhs, const ReceiveBufferPoolStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ ReceiveBufferPoolStats <> JS ReceiveBufferPoolStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::ReceiveBufferPoolStats> final {
+    static inline margelo::nitro::nitrofetchwebsockets::ReceiveBufferPoolStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::ReceiveBufferPoolStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "hits"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "misses"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "residentBytes"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "outstandingBytes")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::ReceiveBufferPoolStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "hits"), JSIConverter<double>::toJSI(runtime, arg.hits));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "misses"), JSIConverter<double>::toJSI(runtime, arg.misses));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "residentBytes"), JSIConverter<double>::toJSI(runtime, arg.residentBytes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "outstandingBytes"), JSIConverter<double>::toJSI(runtime, arg.outstandingBytes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "hits")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "misses")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "residentBytes")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "outstandingBytes")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,111 @@
+///
+/// ServiceQueueStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ServiceQueueStats).
+   */
+  struct ServiceQueueStats final {
+  public:
+    double scheduled     SWIFT_PRIVATE;
+    double wakeups     SWIFT_PRIVATE;
+    double heapTasks     SWIFT_PRIVATE;
+    double fullWaits     SWIFT_PRIVATE;
+    double depth     SWIFT_PRIVATE;
+    double maxDepth     SWIFT_PRIVATE;
+    double meanLatencyUs     SWIFT_PRIVATE;
+    double maxLatencyUs     SWIFT_PRIVATE;
+
+  public:
+    ServiceQueueStats() = default;
+    explicit ServiceQueueStats(double scheduled, double wakeups, double heapTasks, double fullWaits, double depth, double maxDepth, double meanLatencyUs, double maxLatencyUs): scheduled(scheduled), wakeups(wakeups), heapTasks(heapTasks), fullWaits(fullWaits), depth(depth), maxDepth(maxDepth), meanLatencyUs(meanLatencyUs), maxLatencyUs(maxLatencyUs) {}
+
+  public:
+    friend bool operator==(const ServiceQueueStats& lhs, const ServiceQueueStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ ServiceQueueStats <> JS ServiceQueueStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::ServiceQueueStats> final {
+    static inline margelo::nitro::nitrofetchwebsockets::ServiceQueueStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::ServiceQueueStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "scheduled"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "wakeups"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "heapTasks"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fullWaits"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "depth"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxDepth"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "meanLatencyUs"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxLatencyUs")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::ServiceQueueStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "scheduled"), JSIConverter<double>::toJSI(runtime, arg.scheduled));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "wakeups"), JSIConverter<double>::toJSI(runtime, arg.wakeups));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "heapTasks"), JSIConverter<double>::toJSI(runtime, arg.heapTasks));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "fullWaits"), JSIConverter<double>::toJSI(runtime, arg.fullWaits));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "depth"), JSIConverter<double>::toJSI(runtime, arg.depth));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxDepth"), JSIConverter<double>::toJSI(runtime, arg.maxDepth));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "meanLatencyUs"), JSIConverter<double>::toJSI(runtime, arg.meanLatencyUs));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxLatencyUs"), JSIConverter<double>::toJSI(runtime, arg.maxLatencyUs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "scheduled")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "wakeups")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "heapTasks")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fullWaits")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "depth")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxDepth")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "meanLatencyUs")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxLatencyUs")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,111 @@
+///
+/// ServiceThreadStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ServiceThreadStats).
+   */
+  struct ServiceThreadStats final {
+  public:
+    double index     SWIFT_PRIVATE;
+    double connections     SWIFT_PRIVATE;
+    double connectionsTotal     SWIFT_PRIVATE;
+    double cpuTimeMs     SWIFT_PRIVATE;
+    double scheduled     SWIFT_PRIVATE;
+    double depth     SWIFT_PRIVATE;
+    double meanLatencyUs     SWIFT_PRIVATE;
+    double maxLatencyUs     SWIFT_PRIVATE;
+
+  public:
+    ServiceThreadStats() = default;
+    explicit ServiceThreadStats(double index, double connections, double connectionsTotal, double cpuTimeMs, double scheduled, double depth, double meanLatencyUs, double maxLatencyUs): index(index), connections(connections), connectionsTotal(connectionsTotal), cpuTimeMs(cpuTimeMs), scheduled(scheduled), depth(depth), meanLatencyUs(meanLatencyUs), maxLatencyUs(maxLatencyUs) {}
+
+  public:
+    friend bool operator==(const ServiceThreadStats& lhs, const ServiceThreadStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ ServiceThreadStats <> JS ServiceThreadStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::ServiceThreadStats> final {
+    static inline margelo::nitro::nitrofetchwebsockets::ServiceThreadStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::ServiceThreadStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "index"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "connections"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "connectionsTotal"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "cpuTimeMs"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "scheduled"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "depth"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "meanLatencyUs"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxLatencyUs")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::ServiceThreadStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "index"), JSIConverter<double>::toJSI(runtime, arg.index));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "connections"), JSIConverter<double>::toJSI(runtime, arg.connections));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "connectionsTotal"), JSIConverter<double>::toJSI(runtime, arg.connectionsTotal));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "cpuTimeMs"), JSIConverter<double>::toJSI(runtime, arg.cpuTimeMs));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "scheduled"), JSIConverter<double>::toJSI(runtime, arg.scheduled));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "depth"), JSIConverter<double>::toJSI(runtime, arg.depth));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "meanLatencyUs"), JSIConverter<double>::toJSI(runtime, arg.meanLatencyUs));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxLatencyUs"), JSIConverter<double>::toJSI(runtime, arg.maxLatencyUs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "index")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "connections")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "connectionsTotal")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "cpuTimeMs")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "scheduled")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "depth")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "meanLatencyUs")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxLatencyUs")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,87 @@
+///
+/// TlsSessionCacheOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TlsSessionCacheOptions).
+   */
+  struct TlsSessionCacheOptions final {
+  public:
+    std::optional<double> maxEntries     SWIFT_PRIVATE;
+    std::optional<double> maxAgeSeconds     SWIFT_PRIVATE;
+
+  public:
+    TlsSessionCacheOptions() = default;
+    explicit TlsSessionCacheOptions(std::optional<double> maxEntries, std::optional<double> maxAgeSeconds): maxEntries(maxEntries), maxAgeSeconds(maxAgeSeconds) {}
+
+  public:
+    friend bool operator==(const TlsSessionCacheOptions& lhs, const TlsSessionCacheOptions& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ TlsSessionCacheOptions <> JS TlsSessionCacheOptions (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::TlsSessionCacheOptions> final {
+    static inline margelo::nitro::nitrofetchwebsockets::TlsSessionCacheOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::TlsSessionCacheOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxEntries"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxAgeSeconds")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::TlsSessionCacheOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxEntries"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxEntries));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxAgeSeconds"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxAgeSeconds));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxEntries")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxAgeSeconds")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,103 @@
+///
+/// TlsSessionStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TlsSessionStats).
+   */
+  struct TlsSessionStats final {
+  public:
+    double fullHandshakes     SWIFT_PRIVATE;
+    double resumedHandshakes     SWIFT_PRIVATE;
+    double offered     SWIFT_PRIVATE;
+    double restored     SWIFT_PRIVATE;
+    double cached     SWIFT_PRIVATE;
+    bool persistent     SWIFT_PRIVATE;
+
+  public:
+    TlsSessionStats() = default;
+    explicit TlsSessionStats(double fullHandshakes, double resumedHandshakes, double offered, double restored, double cached, bool persistent): fullHandshakes(fullHandshakes), resumedHandshakes(resumedHandshakes), offered(offered), restored(restored), cached(cached), persistent(persistent) {}
+
+  public:
+    friend bool operator==(const TlsSessionStats& lhs, const TlsSessionStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ TlsSessionStats <> JS TlsSessionStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::TlsSessionStats> final {
+    static inline margelo::nitro::nitrofetchwebsockets::TlsSessionStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::TlsSessionStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fullHandshakes"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "resumedHandshakes"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "offered"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "restored"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "cached"))),
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "persistent")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::TlsSessionStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "fullHandshakes"), JSIConverter<double>::toJSI(runtime, arg.fullHandshakes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "resumedHandshakes"), JSIConverter<double>::toJSI(runtime, arg.resumedHandshakes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "offered"), JSIConverter<double>::toJSI(runtime, arg.offered));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "restored"), JSIConverter<double>::toJSI(runtime, arg.restored));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "cached"), JSIConverter<double>::toJSI(runtime, arg.cached));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "persistent"), JSIConverter<bool>::toJSI(runtime, arg.persistent));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fullHandshakes")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "resumedHandshakes")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "offered")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "restored")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "cached")))) return false;
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "persistent")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,119 @@
+///
+/// WebSocketCompressionStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+  /**
+   * A struct which can be represented as a JavaScript object (WebSocketCompressionStats).
+   */
+  struct WebSocketCompressionStats final {
+  public:
+    double messagesSent     SWIFT_PRIVATE;
+    double messagesSentCompressed     SWIFT_PRIVATE;
+    double bytesSent     SWIFT_PRIVATE;
+    double bytesSentOnWire     SWIFT_PRIVATE;
+    double lastSentRatio     SWIFT_PRIVATE;
+    double messagesReceived     SWIFT_PRIVATE;
+    double messagesReceivedCompressed     SWIFT_PRIVATE;
+    double bytesReceived     SWIFT_PRIVATE;
+    double bytesReceivedOnWire     SWIFT_PRIVATE;
+    double lastReceivedRatio     SWIFT_PRIVATE;
+
+  public:
+    WebSocketCompressionStats() = default;
+    explicit WebSocketCompressionStats(double messagesSent, double messagesSentCompressed, double bytesSent, double bytesSentOnWire, double lastSentRatio, double messagesReceived, double messagesReceivedCompressed, double bytesReceived, double bytesReceivedOnWire, double lastReceivedRatio): messagesSent(messagesSent), messagesSentCompressed(messagesSentCompressed), bytesSent(bytesSent), bytesSentOnWire(bytesSentOnWire), lastSentRatio(lastSentRatio), messagesReceived(messagesReceived), messagesReceivedCompressed(messagesReceivedCompressed), bytesReceived(bytesReceived), bytesReceivedOnWire(bytesReceivedOnWire), lastReceivedRatio(lastReceivedRatio) {}
+
+  public:
+    friend bool operator==(const WebSocketCompressionStats& lhs, const WebSocketCompressionStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::nitrofetchwebsockets
+
+namespace margelo::nitro {
+
+  // C++ WebSocketCompressionStats <> JS WebSocketCompressionStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrofetchwebsockets::WebSocketCompressionStats> final {
+    static inline margelo::nitro::nitrofetchwebsockets::WebSocketCompressionStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrofetchwebsockets::WebSocketCompressionStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "messagesSent"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "messagesSentCompressed"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesSent"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesSentOnWire"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "lastSentRatio"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "messagesReceived"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "messagesReceivedCompressed"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesReceived"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesReceivedOnWire"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "lastReceivedRatio")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrofetchwebsockets::WebSocketCompressionStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "messagesSent"), JSIConverter<double>::toJSI(runtime, arg.messagesSent));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "messagesSentCompressed"), JSIConverter<double>::toJSI(runtime, arg.messagesSentCompressed));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "bytesSent"), JSIConverter<double>::toJSI(runtime, arg.bytesSent));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "bytesSentOnWire"), JSIConverter<double>::toJSI(runtime, arg.bytesSentOnWire));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "lastSentRatio"), JSIConverter<double>::toJSI(runtime, arg.lastSentRatio));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "messagesReceived"), JSIConverter<double>::toJSI(runtime, arg.messagesReceived));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "messagesReceivedCompressed"), JSIConverter<double>::toJSI(runtime, arg.messagesReceivedCompressed));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "bytesReceived"), JSIConverter<double>::toJSI(runtime, arg.bytesReceived));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "bytesReceivedOnWire"), JSIConverter<double>::toJSI(runtime, arg.bytesReceivedOnWire));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "lastReceivedRatio"), JSIConverter<double>::toJSI(runtime, arg.lastReceivedRatio));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "messagesSent")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "messagesSentCompressed")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesSent")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesSentOnWire")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "lastSentRatio")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "messagesReceived")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "messagesReceivedCompressed")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesReceived")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesReceivedOnWire")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "lastReceivedRatio")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
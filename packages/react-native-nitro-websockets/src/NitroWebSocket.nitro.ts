@@ -13,6 +13,138 @@ export interface WebSocketCloseEvent {
   wasClean: boolean
 }
 
+/**
+ * RFC 7692 permessage-deflate offer. Window bits are 9–15; omitted fields
+ * leave the choice to the server.
+ */
+export interface PerMessageDeflateOptions {
+  /** Largest LZ77 window our compressor may use. */
+  clientMaxWindowBits?: number
+  /** Largest LZ77 window the server's compressor may use. */
+  serverMaxWindowBits?: number
+  /** Reset our compressor after every message (less memory, worse ratio). */
+  clientNoContextTakeover?: boolean
+  /** Ask the server to reset its compressor after every message. */
+  serverNoContextTakeover?: boolean
+  /** Outgoing messages shorter than this many bytes are sent uncompressed. Default 64. */
+  minCompressSize?: number
+}
+
+/**
+ * Payload byte counts before (`bytes*`) and after (`bytes*OnWire`)
+ * permessage-deflate. Ratios are uncompressed / compressed size of the
+ * last compressed message, 0 until there is one.
+ */
+export interface WebSocketCompressionStats {
+  messagesSent: number
+  messagesSentCompressed: number
+  bytesSent: number
+  bytesSentOnWire: number
+  lastSentRatio: number
+  messagesReceived: number
+  messagesReceivedCompressed: number
+  bytesReceived: number
+  bytesReceivedOnWire: number
+  lastReceivedRatio: number
+}
+
+/**
+ * Process-wide pool that backs received message ArrayBuffers. `hits` /
+ * `misses` count allocations served from / not served from recycled
+ * storage; `residentBytes` is idle storage the pool holds, and
+ * `outstandingBytes` is storage still owned by live ArrayBuffers.
+ */
+export interface ReceiveBufferPoolStats {
+  hits: number
+  misses: number
+  residentBytes: number
+  outstandingBytes: number
+}
+
+/**
+ * Process-wide queue that hands work from JS to the libwebsockets service
+ * thread (Android). `wakeups` counts the times the service thread had to be
+ * interrupted (the rest were coalesced); `heapTasks` are operations too
+ * large for inline storage; `fullWaits` are sends that found the queue
+ * full. Latencies are from scheduling to execution. All zero on iOS.
+ */
+export interface ServiceQueueStats {
+  scheduled: number
+  wakeups: number
+  heapTasks: number
+  fullWaits: number
+  depth: number
+  maxDepth: number
+  meanLatencyUs: number
+  maxLatencyUs: number
+}
+
+/**
+ * One libwebsockets service thread (Android). `connections` are the live
+ * sockets pinned to it, `connectionsTotal` all it was ever given;
+ * `cpuTimeMs` is the thread's CPU time, which includes TLS, inflate and
+ * callback work. The queue fields are as in ServiceQueueStats.
+ */
+export interface ServiceThreadStats {
+  index: number
+  connections: number
+  connectionsTotal: number
+  cpuTimeMs: number
+  scheduled: number
+  depth: number
+  meanLatencyUs: number
+  maxLatencyUs: number
+}
+
+/**
+ * Pool of sockets opened at app start (see prewarmOnAppStart). Omitted
+ * fields take their defaults: 1 connection per endpoint, 60 s idle TTL,
+ * exact query match, 1 MiB of pending messages with the oldest dropped.
+ */
+export interface PrewarmPoolOptions {
+  maxPerEndpoint?: number
+  idleTtlMs?: number
+  /** Query parameters that do not affect matching, e.g. ['token']. */
+  ignoreQueryParams?: string[]
+  ignoreAllQueryParams?: boolean
+  /** Per warm socket, received before it is claimed. 0 = unlimited. */
+  maxPendingBytes?: number
+  /** Close (1008) instead of dropping the oldest messages. */
+  closeOnPendingOverflow?: boolean
+}
+
+export interface PrewarmPoolStats {
+  claims: number
+  hits: number
+  misses: number
+  expired: number
+  closed: number
+  replaced: number
+  droppedMessages: number
+  warm: number
+}
+
+/**
+ * TLS session resumption cache (Android). Omitted fields take their
+ * defaults: 32 host:port entries, sessions offered for up to 24 hours.
+ */
+export interface TlsSessionCacheOptions {
+  maxEntries?: number
+  maxAgeSeconds?: number
+}
+
+export interface TlsSessionStats {
+  fullHandshakes: number
+  resumedHandshakes: number
+  /** Stored sessions handed to a connect, resumed or not. */
+  offered: number
+  /** Sessions read from the encrypted file at startup. */
+  restored: number
+  cached: number
+  /** Whether NitroWebSocketTlsSessions.enablePersistence() ran. */
+  persistent: boolean
+}
+
 export interface HybridWebSocket extends HybridObject<{
   ios: 'c++'
   android: 'c++'
@@ -31,6 +163,23 @@ export interface HybridWebSocket extends HybridObject<{
   close(code: number, reason: string): void
   send(data: string): void
   sendBinary(data: ArrayBuffer): void
+  /** Offer permessage-deflate on the next connect(). Android only. */
+  setPerMessageDeflate(options: PerMessageDeflateOptions): void
+  /** Window and size cap for batches delivered to setMessagesHandler(). */
+  setMessageBatching(windowMs: number, maxMessages: number): void
+  getCompressionStats(): WebSocketCompressionStats
+  getReceiveBufferPoolStats(): ReceiveBufferPoolStats
+  getServiceQueueStats(): ServiceQueueStats
+  /** Process-wide; applies to sockets created afterwards. Android only. */
+  setServiceThreadCount(count: number): void
+  getServiceThreadStats(): ServiceThreadStats[]
+  /** Process-wide; also applies to sockets already warm. */
+  configurePrewarmPool(options: PrewarmPoolOptions): void
+  getPrewarmPoolStats(): PrewarmPoolStats
+  /** Process-wide. Android only; iOS resumes sessions on its own. */
+  configureTlsSessionCache(options: TlsSessionCacheOptions): void
+  getTlsSessionStats(): TlsSessionStats
+  clearTlsSessionCache(): void
   onOpen: (() => void) | undefined
   onMessage: ((event: HybridWebSocketMessageEvent) => void) | undefined
   onClose: ((event: WebSocketCloseEvent) => void) | undefined
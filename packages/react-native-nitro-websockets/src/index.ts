@@ -1,16 +1,30 @@
 import { NitroModules } from 'react-native-nitro-modules'
-import { TextDecoder } from 'react-native-nitro-text-decoder'
 import type {
   HybridWebSocket,
-  HybridWebSocketMessageEvent,
+  PerMessageDeflateOptions,
+  ReceiveBufferPoolStats,
+  ServiceQueueStats,
+  ServiceThreadStats,
+  TlsSessionCacheOptions,
+  TlsSessionStats,
   WebSocketCloseEvent as NitroWSCloseEvent,
+  WebSocketCompressionStats,
 } from './NitroWebSocket.nitro'
 
 export { createWebSocket } from './NitroWebSocket.nitro'
 export type {
   HybridWebSocket,
   HybridWebSocketMessageEvent,
+  PerMessageDeflateOptions,
+  PrewarmPoolOptions,
+  PrewarmPoolStats,
+  ReceiveBufferPoolStats,
+  ServiceQueueStats,
+  ServiceThreadStats,
+  TlsSessionCacheOptions,
+  TlsSessionStats,
   WebSocketCloseEvent,
+  WebSocketCompressionStats,
   WebSocketReadyState,
 } from './NitroWebSocket.nitro'
 
@@ -20,13 +34,89 @@ export type WebSocketMessageEvent = {
   binaryData?: ArrayBuffer
 }
 
+export type NitroWebSocketOptions = {
+  /**
+   * Offer permessage-deflate (RFC 7692). `true` uses the defaults; the
+   * server decides whether it is used (see `extensions` once open).
+   * Android only; ignored on iOS.
+   */
+  perMessageDeflate?: boolean | PerMessageDeflateOptions
+  /**
+   * How `onmessages` batches are formed: a batch is delivered when
+   * `windowMs` (default 16) has passed since the previous delivery or it
+   * holds `maxMessages` (default 128) messages, whichever comes first.
+   */
+  batch?: { windowMs?: number; maxMessages?: number }
+}
+
+/**
+ * Number of native service threads sockets are spread over (Android,
+ * 1–8, default 1). Each new socket goes to the thread with the fewest open
+ * connections and stays there, so a busy feed no longer delays the others.
+ * Affects sockets created afterwards; call it early, e.g. at startup.
+ */
+export function setServiceThreadCount(count: number): void {
+  NitroModules.createHybridObject<HybridWebSocket>(
+    'WebSocket'
+  ).setServiceThreadCount(count)
+}
+
+/**
+ * Size and age limit of the TLS session cache (Android). `wss://`
+ * connections offer the last session seen for the same host:port, on any
+ * service thread, so reconnects skip the full handshake. To keep sessions
+ * across launches, call `NitroWebSocketTlsSessions.enablePersistence()`
+ * from `Application.onCreate()`.
+ */
+export function configureTlsSessionCache(
+  options: TlsSessionCacheOptions
+): void {
+  NitroModules.createHybridObject<HybridWebSocket>(
+    'WebSocket'
+  ).configureTlsSessionCache(options)
+}
+
+/** Full vs resumed TLS handshakes and cache counters (zeros on iOS). */
+export function getTlsSessionStats(): TlsSessionStats {
+  return NitroModules.createHybridObject<HybridWebSocket>(
+    'WebSocket'
+  ).getTlsSessionStats()
+}
+
+/**
+ * Forget stored TLS sessions, including the file, e.g. on sign-out since
+ * a session ticket lets the server recognise the device.
+ */
+export function clearTlsSessionCache(): void {
+  NitroModules.createHybridObject<HybridWebSocket>(
+    'WebSocket'
+  ).clearTlsSessionCache()
+}
+
 export {
   prewarmOnAppStart,
   removeFromPrewarmQueue,
   clearPrewarmQueue,
+  configurePrewarmPool,
+  getPrewarmPoolStats,
 } from './prewarm'
 
-const utf8Decoder = new TextDecoder('utf-8', { fatal: false, ignoreBOM: true })
+// UTF-8 size of a received text message, for the network inspector.
+function utf8ByteLength(text: string): number {
+  let bytes = text.length
+  for (let i = 0; i < text.length; i++) {
+    const c = text.charCodeAt(i)
+    if (c >= 0xd800 && c <= 0xdbff) {
+      bytes += 1 // surrogate pair: 2 UTF-16 units, 4 bytes
+      i++
+    } else if (c >= 0x800) {
+      bytes += 2
+    } else if (c >= 0x80) {
+      bytes += 1
+    }
+  }
+  return bytes
+}
 
 // Try-import NetworkInspector from fetch package (optional peer dep)
 let _inspector: any = null
@@ -34,6 +124,40 @@ try {
   _inspector = require('react-native-nitro-fetch').NetworkInspector
 } catch {}
 
+function toMessageEvent(
+  data: string | ArrayBuffer,
+  isBinary: boolean
+): WebSocketMessageEvent {
+  return isBinary
+    ? { data: '', isBinary: true, binaryData: data as ArrayBuffer }
+    : { data: data as string, isBinary: false }
+}
+
+function recordReceived(
+  inspectorId: string | undefined,
+  e: WebSocketMessageEvent
+) {
+  if (!inspectorId || !_inspector?.isEnabled()) return
+  if (e.isBinary) {
+    const size = e.binaryData?.byteLength ?? 0
+    _inspector._recordWsMessage(
+      inspectorId,
+      'received',
+      `[binary ${size} bytes]`,
+      size,
+      true
+    )
+  } else {
+    _inspector._recordWsMessage(
+      inspectorId,
+      'received',
+      e.data,
+      utf8ByteLength(e.data),
+      false
+    )
+  }
+}
+
 function generateWsId(): string {
   return 'ws-' + String(Date.now()) + '-' + String(Math.random()).slice(2, 8)
 }
@@ -49,9 +173,20 @@ export class NitroWebSocket {
   constructor(
     url: string,
     protocols?: string | string[],
-    headers?: Record<string, string>
+    headers?: Record<string, string>,
+    options?: NitroWebSocketOptions
   ) {
     this._ws = NitroModules.createHybridObject<HybridWebSocket>('WebSocket')
+    const deflate = options?.perMessageDeflate
+    if (deflate) {
+      this._ws.setPerMessageDeflate(deflate === true ? {} : deflate)
+    }
+    if (options?.batch) {
+      this._ws.setMessageBatching(
+        options.batch.windowMs ?? 16,
+        options.batch.maxMessages ?? 128
+      )
+    }
     const protocolList = protocols
       ? Array.isArray(protocols)
         ? protocols
@@ -105,48 +240,37 @@ export class NitroWebSocket {
     }
   }
   set onmessage(fn: ((e: WebSocketMessageEvent) => void) | null) {
+    const ws = this._ws as any
     if (fn == null) {
-      this._ws.onMessage = undefined
+      ws.setMessageHandler(undefined)
       return
     }
     const inspectorId = this._inspectorId
-    this._ws.onMessage = (native: HybridWebSocketMessageEvent) => {
-      if (native.isBinary) {
-        const size = native.data.byteLength
-        if (inspectorId && _inspector?.isEnabled()) {
-          _inspector._recordWsMessage(
-            inspectorId,
-            'received',
-            `[binary ${size} bytes]`,
-            size,
-            true
-          )
-        }
-        fn({
-          data: '',
-          isBinary: true,
-          binaryData: native.data,
-        })
-      } else {
-        const buf = native.data
-        const text =
-          buf.byteLength === 0 ? '' : utf8Decoder.decode(buf, { stream: false })
-        const size = buf.byteLength
-        if (inspectorId && _inspector?.isEnabled()) {
-          _inspector._recordWsMessage(
-            inspectorId,
-            'received',
-            text,
-            size,
-            false
-          )
-        }
-        fn({
-          data: text,
-          isBinary: false,
-        })
-      }
+    // Native validates text frames (closing with 1007 on bad UTF-8) and
+    // passes them as strings, so nothing is decoded here.
+    ws.setMessageHandler((data: string | ArrayBuffer, isBinary: boolean) => {
+      const e = toMessageEvent(data, isBinary)
+      recordReceived(inspectorId, e)
+      fn(e)
+    })
+  }
+  /**
+   * Batched delivery: messages are gathered natively and handed over as
+   * one array per JS call (see `batch` in the options). A message arriving
+   * after a quiet window is delivered right away, through `onmessage` when
+   * that is also set, otherwise as a one-element batch.
+   */
+  set onmessages(fn: ((events: WebSocketMessageEvent[]) => void) | null) {
+    const ws = this._ws as any
+    if (fn == null) {
+      ws.setMessagesHandler(undefined)
+      return
     }
+    const inspectorId = this._inspectorId
+    ws.setMessagesHandler((events: WebSocketMessageEvent[]) => {
+      for (const e of events) recordReceived(inspectorId, e)
+      fn(events)
+    })
   }
   set onclose(fn: ((e: NitroWSCloseEvent) => void) | null) {
     if (fn == null) {
@@ -175,7 +299,7 @@ export class NitroWebSocket {
     }
   }
 
-  send(data: string | ArrayBuffer) {
+  send(data: string | ArrayBuffer | ArrayBufferView) {
     if (typeof data === 'string') {
       if (this._inspectorId && _inspector?.isEnabled()) {
         _inspector._recordWsMessage(
@@ -197,11 +321,41 @@ export class NitroWebSocket {
           true
         )
       }
-      this._ws.sendBinary(data)
+      // Native resolves views itself and sends only the bytes they cover.
+      ;(this._ws as any).sendBinary(data)
     }
   }
 
   close(code = 1000, reason = '') {
     this._ws.close(code, reason)
   }
+
+  /** Message and byte counts before and after permessage-deflate. */
+  getCompressionStats(): WebSocketCompressionStats {
+    return this._ws.getCompressionStats()
+  }
+
+  /**
+   * Counters of the receive buffer pool. The pool is shared by every
+   * socket in the process, so any instance reports the same numbers.
+   */
+  getReceiveBufferPoolStats(): ReceiveBufferPoolStats {
+    return this._ws.getReceiveBufferPoolStats()
+  }
+
+  /**
+   * Counters of the queue that carries sends and other operations to the
+   * native service thread (Android; zeros on iOS). Shared by every socket.
+   */
+  getServiceQueueStats(): ServiceQueueStats {
+    return this._ws.getServiceQueueStats()
+  }
+
+  /**
+   * Load of each native service thread that has been started (Android;
+   * empty on iOS). See `setServiceThreadCount`.
+   */
+  getServiceThreadStats(): ServiceThreadStats[] {
+    return this._ws.getServiceThreadStats()
+  }
 }
@@ -1,4 +1,9 @@
 import { type HybridObject, NitroModules } from 'react-native-nitro-modules'
+import type {
+  HybridWebSocket,
+  PrewarmPoolOptions,
+  PrewarmPoolStats,
+} from './NitroWebSocket.nitro'
 
 const WS_PREWARM_KEY = 'nitro_ws_prewarm_queue'
 
@@ -80,3 +85,25 @@ export function clearPrewarmQueue(): void {
   const storage = getStorage()
   storage.removeString(WS_PREWARM_KEY)
 }
+
+function getWebSocket(): HybridWebSocket {
+  return NitroModules.createHybridObject<HybridWebSocket>('WebSocket')
+}
+
+/**
+ * Configure the native pool that holds prewarmed sockets until a
+ * `NitroWebSocket` claims them. Sockets match by endpoint (scheme, host,
+ * port, path and the query minus ignored parameters), so a rotating token
+ * can be listed in `ignoreQueryParams` instead of causing a miss.
+ *
+ * Prewarming starts before JS runs, with the defaults; call this early so
+ * matching, TTL and buffer limits apply to those sockets as well.
+ */
+export function configurePrewarmPool(options: PrewarmPoolOptions): void {
+  getWebSocket().configurePrewarmPool(options)
+}
+
+/** Claim / hit / miss / eviction counters of the prewarm pool. */
+export function getPrewarmPoolStats(): PrewarmPoolStats {
+  return getWebSocket().getPrewarmPoolStats()
+}
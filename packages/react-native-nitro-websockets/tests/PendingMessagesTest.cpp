@@ -0,0 +1,81 @@
+#include "PendingMessages.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace margelo::nitro::nitrofetchwebsockets;
+
+namespace {
+
+using Overflow = PendingMessages::Overflow;
+
+// A payload of `size` bytes, each set to `tag`.
+PooledPayload payload(size_t size, uint8_t tag = 'x') {
+  std::vector<uint8_t> bytes(size, tag);
+  return PooledPayload::copyOf(bytes.data(), size);
+}
+
+std::vector<uint8_t> tags(std::deque<PendingMessages::Message> messages) {
+  std::vector<uint8_t> out;
+  for (auto& m : messages) out.push_back(m.data.data()[0]);
+  return out;
+}
+
+} // namespace
+
+TEST(PendingMessages, UnlimitedByDefault) {
+  PendingMessages pending;
+  for (int i = 0; i < 100; ++i) EXPECT_TRUE(pending.push(payload(1000), false));
+  EXPECT_EQ(pending.take().size(), 100u);
+  EXPECT_EQ(pending.dropped(), 0u);
+}
+
+TEST(PendingMessages, DropOldestKeepsNewestWithinCap) {
+  PendingMessages pending;
+  pending.setLimit(100, Overflow::DropOldest);
+  EXPECT_TRUE(pending.push(payload(40, 'a'), false));
+  EXPECT_TRUE(pending.push(payload(40, 'b'), true));
+  EXPECT_TRUE(pending.push(payload(40, 'c'), false));
+
+  auto messages = pending.take();
+  EXPECT_EQ(tags(std::move(messages)), (std::vector<uint8_t>{ 'b', 'c' }));
+  EXPECT_EQ(pending.dropped(), 1u);
+}
+
+TEST(PendingMessages, ExactFitIsKept) {
+  PendingMessages pending;
+  pending.setLimit(100, Overflow::DropOldest);
+  EXPECT_TRUE(pending.push(payload(60), false));
+  EXPECT_TRUE(pending.push(payload(40), false));
+  EXPECT_EQ(pending.take().size(), 2u);
+  EXPECT_EQ(pending.dropped(), 0u);
+}
+
+TEST(PendingMessages, MessageLargerThanCapIsDropped) {
+  PendingMessages pending;
+  pending.setLimit(100, Overflow::DropOldest);
+  EXPECT_TRUE(pending.push(payload(50), false));
+  EXPECT_TRUE(pending.push(payload(101), false));
+  EXPECT_TRUE(pending.take().empty());
+  EXPECT_EQ(pending.dropped(), 2u);
+}
+
+TEST(PendingMessages, CloseRejectsWithoutDroppingQueued) {
+  PendingMessages pending;
+  pending.setLimit(100, Overflow::Close);
+  EXPECT_TRUE(pending.push(payload(80, 'a'), false));
+  EXPECT_FALSE(pending.push(payload(21, 'b'), false));
+
+  EXPECT_EQ(tags(pending.take()), (std::vector<uint8_t>{ 'a' }));
+  EXPECT_EQ(pending.dropped(), 1u);
+}
+
+TEST(PendingMessages, TakeFreesTheBudget) {
+  PendingMessages pending;
+  pending.setLimit(100, Overflow::Close);
+  EXPECT_TRUE(pending.push(payload(100), false));
+  pending.take();
+  EXPECT_TRUE(pending.push(payload(100), false));
+  EXPECT_EQ(pending.dropped(), 0u);
+}
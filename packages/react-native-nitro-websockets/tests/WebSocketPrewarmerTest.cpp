@@ -0,0 +1,216 @@
+#include "WebSocketConnection.hpp"
+#include "WebSocketPrewarmer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace margelo::nitro::nitrofetchwebsockets;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Config = WebSocketPrewarmer::Config;
+using Overflow = WebSocketConnectionBase::BufferOverflow;
+
+std::string key(const std::string& url, const Config& config = {}) {
+  return WebSocketPrewarmer::endpointKey(url, config);
+}
+
+// The prewarmer is process-wide; each test starts from an empty pool and
+// compares counters against where they were.
+class PrewarmerTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    Config drain;
+    drain.idleTtl = 0ms;
+    pool().configure(drain);
+    pool().configure(Config{});
+    before = pool().stats();
+  }
+  void TearDown() override {
+    Config drain;
+    drain.idleTtl = 0ms;
+    pool().configure(drain);
+  }
+
+  static WebSocketPrewarmer& pool() { return WebSocketPrewarmer::instance(); }
+
+  static WebSocketConnection& warm(const std::string& url) {
+    pool().preConnect(url, {}, {});
+    return *WebSocketConnection::lastCreated;
+  }
+
+  WebSocketPrewarmer::Stats before;
+};
+
+} // namespace
+
+TEST(EndpointKey, DropsDefaultPorts) {
+  EXPECT_EQ(key("wss://example.com:443/feed"), "wss://example.com/feed");
+  EXPECT_EQ(key("ws://example.com:80/feed"), "ws://example.com/feed");
+  EXPECT_EQ(key("wss://example.com:8443/feed"), "wss://example.com:8443/feed");
+  // Only the scheme's own default is dropped.
+  EXPECT_EQ(key("ws://example.com:443/feed"), "ws://example.com:443/feed");
+  EXPECT_EQ(key("wss://example.com:80/feed"), "wss://example.com:80/feed");
+}
+
+TEST(EndpointKey, FoldsSchemeAndHostButNotPathOrQuery) {
+  EXPECT_EQ(key("WSS://Example.COM/Feed?Room=A"), "wss://example.com/Feed?Room=A");
+  EXPECT_EQ(key("WSS://EXAMPLE.com:443"), key("wss://example.com/"));
+}
+
+TEST(EndpointKey, DefaultsPathAndDropsFragment) {
+  EXPECT_EQ(key("wss://example.com"), "wss://example.com/");
+  EXPECT_EQ(key("wss://example.com?a=1"), "wss://example.com/?a=1");
+  EXPECT_EQ(key("wss://example.com/feed?a=1#top"), "wss://example.com/feed?a=1");
+}
+
+TEST(EndpointKey, SortsQueryParams) {
+  EXPECT_EQ(key("wss://h/p?b=2&a=1&c=3"), "wss://h/p?a=1&b=2&c=3");
+  EXPECT_EQ(key("wss://h/p?b=2&a=1"), key("wss://h/p?a=1&b=2"));
+  EXPECT_EQ(key("wss://h/p?&a=1&&b=2&"), "wss://h/p?a=1&b=2");
+  EXPECT_NE(key("wss://h/p?a=1"), key("wss://h/p?a=2"));
+}
+
+TEST(EndpointKey, IgnoresConfiguredQueryParams) {
+  Config config;
+  config.ignoredQueryParams = { "token", "ts" };
+  EXPECT_EQ(key("wss://h/p?token=abc&room=1&ts=9", config), "wss://h/p?room=1");
+  EXPECT_EQ(key("wss://h/p?token=abc", config), "wss://h/p");
+  EXPECT_EQ(key("wss://h/p?token", config), "wss://h/p");
+  // Matched by whole name, case-sensitively.
+  EXPECT_EQ(key("wss://h/p?tokens=1&Token=2", config), "wss://h/p?Token=2&tokens=1");
+}
+
+TEST(EndpointKey, IgnoresAllQueryParams) {
+  Config config;
+  config.ignoreAllQueryParams = true;
+  EXPECT_EQ(key("wss://h/p?token=abc&room=1", config), "wss://h/p");
+  EXPECT_EQ(key("wss://h/p?room=1", config), key("wss://h/p?room=2", config));
+}
+
+TEST_F(PrewarmerTest, ClaimMatchesNormalizedEndpoint) {
+  Config config;
+  config.ignoredQueryParams = { "token" };
+  pool().configure(config);
+
+  auto& conn = warm("wss://Example.com:443/feed?room=1&token=old");
+  auto claimed = pool().tryGet("wss://example.com/feed?token=new&room=1");
+  EXPECT_EQ(claimed.get(), &conn);
+  EXPECT_EQ(pool().tryGet("wss://example.com/feed?token=new&room=1"), nullptr);
+
+  auto stats = pool().stats();
+  EXPECT_EQ(stats.hits - before.hits, 1u);
+  EXPECT_EQ(stats.misses - before.misses, 1u);
+  EXPECT_EQ(stats.warm, 0u);
+}
+
+TEST_F(PrewarmerTest, ExpiryTimerClosesIdleConnection) {
+  Config config;
+  config.idleTtl = 20ms;
+  pool().configure(config);
+
+  auto& conn = warm("wss://h/feed");
+  ASSERT_EQ(conn.tasks.size(), 1u);
+  EXPECT_EQ(conn.tasks[0].delay, 20ms);
+
+  std::this_thread::sleep_for(30ms);
+  conn.runTasks();  // last use of `conn`: expiry releases it
+
+  auto stats = pool().stats();
+  EXPECT_EQ(stats.expired - before.expired, 1u);
+  EXPECT_EQ(stats.warm, 0u);
+  EXPECT_EQ(pool().tryGet("wss://h/feed"), nullptr);
+}
+
+TEST_F(PrewarmerTest, ExpiryClosesWith1001) {
+  Config config;
+  config.idleTtl = 20ms;
+  pool().configure(config);
+
+  auto& conn = warm("wss://h/feed");
+  std::shared_ptr<WebSocketConnectionBase> keep = conn.shared_from_this();
+  std::this_thread::sleep_for(30ms);
+  conn.runTasks();
+
+  EXPECT_EQ(conn.state(), WebSocketConnectionBase::State::CLOSED);
+  EXPECT_EQ(conn.closeCode, 1001);
+}
+
+TEST_F(PrewarmerTest, ExpiryTimerRearmsWhenTtlWasRaised) {
+  Config config;
+  config.idleTtl = 20ms;
+  pool().configure(config);
+  auto& conn = warm("wss://h/feed");
+
+  config.idleTtl = 60000ms;
+  pool().configure(config);
+  std::this_thread::sleep_for(30ms);
+  conn.runTasks();
+
+  EXPECT_EQ(conn.state(), WebSocketConnectionBase::State::OPEN);
+  ASSERT_EQ(conn.tasks.size(), 1u);
+  EXPECT_GT(conn.tasks[0].delay, 59000ms);
+  EXPECT_LE(conn.tasks[0].delay, 60000ms);
+  EXPECT_EQ(pool().stats().warm, 1u);
+}
+
+TEST_F(PrewarmerTest, SweepExpiresWithoutTimer) {
+  Config config;
+  config.idleTtl = 20ms;
+  pool().configure(config);
+  warm("wss://h/feed");
+
+  std::this_thread::sleep_for(30ms);
+  EXPECT_EQ(pool().tryGet("wss://h/feed"), nullptr);
+  EXPECT_EQ(pool().stats().expired - before.expired, 1u);
+}
+
+TEST_F(PrewarmerTest, ReplacesOldestBeyondMaxPerEndpoint) {
+  auto& first = warm("wss://h/feed");
+  std::shared_ptr<WebSocketConnectionBase> keep = first.shared_from_this();
+  auto& second = warm("wss://h/feed");
+
+  EXPECT_EQ(first.closeCode, 1001);
+  EXPECT_EQ(pool().stats().replaced - before.replaced, 1u);
+  EXPECT_EQ(pool().tryGet("wss://h/feed").get(), &second);
+}
+
+TEST_F(PrewarmerTest, AppliesPendingCapAndLiftsItOnClaim) {
+  Config config;
+  config.maxPendingBytes = 100;
+  pool().configure(config);
+
+  auto& conn = warm("wss://h/feed");
+  EXPECT_EQ(conn.pendingLimit, 100u);
+  EXPECT_EQ(conn.pendingPolicy, Overflow::DropOldest);
+
+  for (int i = 0; i < 5; ++i) conn.receive(40);
+  EXPECT_EQ(pool().stats().droppedMessages - before.droppedMessages, 3u);
+
+  auto claimed = pool().tryGet("wss://h/feed");
+  ASSERT_EQ(claimed.get(), &conn);
+  EXPECT_EQ(conn.pendingLimit, 0u);
+  EXPECT_EQ(pool().stats().droppedMessages - before.droppedMessages, 3u);
+}
+
+TEST_F(PrewarmerTest, ConfigureUpdatesCapOfWarmConnections) {
+  auto& conn = warm("wss://h/feed");
+  EXPECT_EQ(conn.pendingLimit, 1024u * 1024u);
+
+  Config config;
+  config.maxPendingBytes = 10;
+  config.pendingOverflow = Overflow::Close;
+  pool().configure(config);
+  EXPECT_EQ(conn.pendingLimit, 10u);
+  EXPECT_EQ(conn.pendingPolicy, Overflow::Close);
+
+  std::shared_ptr<WebSocketConnectionBase> keep = conn.shared_from_this();
+  conn.receive(11);
+  EXPECT_EQ(conn.closeCode, 1008);
+  // Found closed on the next look and evicted.
+  auto stats = pool().stats();
+  EXPECT_EQ(stats.closed - before.closed, 1u);
+  EXPECT_EQ(stats.warm, 0u);
+}
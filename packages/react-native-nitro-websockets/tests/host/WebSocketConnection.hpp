@@ -0,0 +1,87 @@
+/*
+ * Host stand-in for the libwebsockets connection. It opens on connect(),
+ * keeps postDelayed() tasks until a test runs them, and buffers what
+ * receive() is given in a real PendingMessages until a callback is set.
+ */
+
+#pragma once
+
+#include "PendingMessages.hpp"
+#include "WebSocketConnectionBase.hpp"
+
+#include <vector>
+
+namespace margelo::nitro::nitrofetchwebsockets {
+
+
+class WebSocketConnection : public WebSocketConnectionBase {
+public:
+  struct Task { std::chrono::microseconds delay; std::function<void()> fn; };
+
+  WebSocketConnection() { lastCreated = this; }
+  ~WebSocketConnection() override {
+    if (lastCreated == this) lastCreated = nullptr;
+  }
+
+  // Most recent instance still alive, or nullptr.
+  inline static WebSocketConnection* lastCreated = nullptr;
+
+  void connect(const std::string& url,
+               const std::vector<std::string>& /*protocols*/,
+               const std::unordered_map<std::string, std::string>& /*headers*/) override {
+    _url   = url;
+    _state = State::OPEN;
+  }
+  void close(int code, const std::string& /*reason*/) override {
+    closeCode = code;
+    _state    = State::CLOSED;
+  }
+  void send(const std::string&) override {}
+  void sendBinary(const uint8_t*, size_t) override {}
+
+  State state() const override { return _state; }
+  std::string url() const override { return _url; }
+  std::string protocol() const override { return ""; }
+  std::string extensions() const override { return ""; }
+  size_t bufferedAmount() const override { return 0; }
+
+  void postDelayed(std::chrono::microseconds delay, std::function<void()> fn) override {
+    tasks.push_back({ delay, std::move(fn) });
+  }
+
+  void setPendingLimit(size_t maxBytes, BufferOverflow policy) override {
+    pendingLimit  = maxBytes;
+    pendingPolicy = policy;
+    _pending.setLimit(maxBytes, policy);
+  }
+  uint64_t droppedPendingMessages() const override { return _pending.dropped(); }
+
+  void setOnOpen(OnOpen) override {}
+  void setOnMessage(OnMessage) override {}
+  void setOnClose(OnClose) override {}
+  void setOnError(OnError) override {}
+
+  // A text message of `size` bytes arriving before anyone claimed us.
+  void receive(size_t size) {
+    std::vector<uint8_t> bytes(size, 'x');
+    if (!_pending.push(PooledPayload::copyOf(bytes.data(), size), false)) close(1008, "");
+  }
+
+  // Runs and forgets the tasks posted so far.
+  void runTasks() {
+    auto pending = std::exchange(tasks, {});
+    for (auto& task : pending) task.fn();
+  }
+
+  std::vector<Task> tasks;
+  size_t pendingLimit = 0;
+  BufferOverflow pendingPolicy = BufferOverflow::DropOldest;
+  int closeCode = 0;
+
+private:
+  State _state = State::CONNECTING;
+  std::string _url;
+  PendingMessages _pending;
+};
+
+} // namespace margelo::nitro::nitrofetchwebsockets
@@ -210,7 +210,7 @@
 /* #undef LWS_WITH_OTA */
 #define LWS_WITH_CACHE_NSCOOKIEJAR
 #define LWS_WITH_CLIENT
-#define LWS_WITHOUT_EXTENSIONS
+/* #undef LWS_WITHOUT_EXTENSIONS */
 /* #undef LWS_WITH_SERVER */
 /* #undef LWS_WITH_SPAWN */
 /* #undef LWS_WITH_PEER_LIMITS */
@@ -7,7 +7,7 @@
 // Reachable from the emulators/simulators that CI boots on the same host:
 //   - Android emulator -> http://10.0.2.2:9876
 //   - iOS simulator    -> http://127.0.0.1:9876
-import { randomUUID } from 'node:crypto';
+import { createHash, randomUUID } from 'node:crypto';
 import express from 'express';
 import multer from 'multer';
 import { WebSocketServer } from 'ws';
@@ -231,6 +231,14 @@ const server = app.listen(PORT, '0.0.0.0', () => {
 //   /ws/close?code=1011&reason=x&delay=200  -> server-initiated close handshake
 //   /ws/kill?delay=200                      -> socket destroyed, no close frame
 //   /ws/stall                               -> accepts the upgrade, never sends 101
+//   /ws/burst                               -> "burst <n>" is answered with n text
+//                                              messages "0".."n-1", back to back
+//   /ws/invalid-utf8                        -> a valid text message, a text frame
+//                                              whose payload is not UTF-8, then
+//                                              another valid one ("after")
+//   /ws/frames                              -> accepts permessage-deflate when offered
+//                                              and answers each message with its first
+//                                              frame's header as JSON (see below)
 const wss = new WebSocketServer({ noServer: true });
 
 // /ws/stall holds the TCP connection open without completing the handshake, so
@@ -241,6 +249,10 @@ server.on('upgrade', (req, socket, head) => {
     socket.on('error', () => {});
     return;
   }
+  if (url.pathname === '/ws/frames') {
+    frameInspector(req, socket, head);
+    return;
+  }
   wss.handleUpgrade(req, socket, head, (ws) => wss.emit('connection', ws, req));
 });
 
@@ -248,9 +260,24 @@ wss.on('connection', (ws, req) => {
   const url = new URL(req.url, `http://${req.headers.host}`);
   const delay = Number(url.searchParams.get('delay')) || 200;
 
+  if (url.pathname === '/ws/burst') {
+    ws.on('message', (data) => {
+      const n = Math.min(10_000, Number(String(data).split(' ')[1]) || 0);
+      for (let i = 0; i < n; i++) ws.send(String(i));
+    });
+    return;
+  }
+
   ws.on('message', (data, isBinary) => ws.send(data, { binary: isBinary }));
 
-  if (url.pathname === '/ws/headers') {
+  if (url.pathname === '/ws/invalid-utf8') {
+    ws.send('valid');
+    // ws does not check outgoing text, so the raw bytes go out as-is.
+    ws.send(Buffer.from([0x61, 0xff, 0xfe, 0x62]), { binary: false });
+    // Written with the bad frame, so the client usually reads both in one
+    // pass; it must not deliver this once it has failed the connection.
+    ws.send('after');
+  } else if (url.pathname === '/ws/headers') {
     ws.send(JSON.stringify(req.headers));
   } else if (url.pathname === '/ws/close') {
     const code = Number(url.searchParams.get('code')) || 1011;
@@ -260,3 +287,82 @@ wss.on('connection', (ws, req) => {
     setTimeout(() => ws.terminate(), delay);
   }
 });
+
+// /ws/frames speaks the protocol by hand, because ws inflates messages before
+// the application sees them and hides the RSV1 bit that says whether the
+// client compressed one. Each client message is answered with
+// { rsv1, opcode, frames, wireBytes } for its first frame and the bytes it
+// took on the wire; payloads are not inflated. Close frames are echoed.
+function frameInspector(req, socket, head) {
+  socket.on('error', () => {});
+  const accept = createHash('sha1')
+    .update(req.headers['sec-websocket-key'] + '258EAFA5-E914-47DA-95CA-C5AB0DC85B11')
+    .digest('base64');
+  const offered = (req.headers['sec-websocket-extensions'] || '').includes('permessage-deflate');
+  socket.write(
+    'HTTP/1.1 101 Switching Protocols\r\n' +
+      'Upgrade: websocket\r\n' +
+      'Connection: Upgrade\r\n' +
+      `Sec-WebSocket-Accept: ${accept}\r\n` +
+      (offered ? 'Sec-WebSocket-Extensions: permessage-deflate\r\n' : '') +
+      '\r\n'
+  );
+
+  const send = (opcode, payload) => {
+    const header =
+      payload.length < 126
+        ? Buffer.from([0x80 | opcode, payload.length])
+        : Buffer.from([0x80 | opcode, 126, payload.length >> 8, payload.length & 0xff]);
+    socket.write(Buffer.concat([header, payload]));
+  };
+
+  let buffered = head;
+  let message = null;
+  socket.on('data', (chunk) => {
+    buffered = Buffer.concat([buffered, chunk]);
+    for (;;) {
+      if (buffered.length < 2) return;
+      const fin = (buffered[0] & 0x80) !== 0;
+      const rsv1 = (buffered[0] & 0x40) !== 0;
+      const opcode = buffered[0] & 0x0f;
+      let length = buffered[1] & 0x7f;
+      let offset = 2;
+      if (length === 126) {
+        if (buffered.length < 4) return;
+        length = buffered.readUInt16BE(2);
+        offset = 4;
+      } else if (length === 127) {
+        if (buffered.length < 10) return;
+        length = Number(buffered.readBigUInt64BE(2));
+        offset = 10;
+      }
+      const masked = (buffered[1] & 0x80) !== 0;
+      const start = offset + (masked ? 4 : 0);
+      if (buffered.length < start + length) return;
+      const payload = Buffer.from(buffered.subarray(start, start + length));
+      if (masked) {
+        for (let i = 0; i < length; i++) payload[i] ^= buffered[offset + (i & 3)];
+      }
+      buffered = buffered.subarray(start + length);
+
+      if (opcode === 0x8) {
+        send(0x8, payload.subarray(0, 125));
+        socket.end();
+        return;
+      }
+      if (opcode === 0x9) {
+        send(0xa, payload);
+        continue;
+      }
+      if (opcode === 0xa) continue;
+      if (opcode !== 0x0) message = { rsv1, opcode, frames: 0, wireBytes: 0 };
+      if (!message) continue;
+      message.frames++;
+      message.wireBytes += length;
+      if (fin) {
+        send(0x1, Buffer.from(JSON.stringify(message)));
+        message = null;
+      }
+    }
+  });
+}